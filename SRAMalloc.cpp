@@ -0,0 +1,41 @@
+/*  SRAMalloc.cpp - Hand out space on a 23LC1024 instead of hard-coding addresses.
+ *  Extends SRAMsimple, by David Dubins.
+ *  Released into the public domain.
+ */
+
+#include "Arduino.h"
+#include "SRAMalloc.h"
+
+SRAMarena::SRAMarena(uint32_t address, uint32_t size){
+  _start=address;
+  _end=address+size;
+  _highWater=_start;
+  _failures=0;
+  Reset();
+}
+
+/*  big bytes, starting on a multiple of align (a power of 2: SRAMpage keeps small
+ *  allocations inside one page; 0 means 1). SRAMnull if there isn't room **********/
+uint32_t SRAMarena::Alloc(uint32_t big, uint16_t align){
+  if(align==0) align=1;                           // align-1 would wrap to all ones
+  uint32_t address=(_top+align-1)&~(uint32_t)(align-1);
+  if(address<_top || address>_end || big>_end-address){
+    _failures++;
+    return SRAMnull;
+  }
+  _padding+=address-_top;
+  _top=address+big;
+  if(_top>_highWater) _highWater=_top;
+  return address;
+}
+
+/*  Free everything allocated since Mark() returned mark **********/
+void SRAMarena::Release(uint32_t mark){
+  if(mark>=_start && mark<=_top) _top=mark;
+}
+
+/*  Free everything (the counters other than Padding() keep going) **********/
+void SRAMarena::Reset(){
+  _top=_start;
+  _padding=0;
+}
@@ -0,0 +1,146 @@
+/*  SRAMalloc.h - Hand out space on a 23LC1024 (SRAMsimple or SRAMbank) instead of hard-coding addresses.
+ *  SRAMarena: bump allocator over a range of addresses. Alloc() just moves a pointer up, Reset()
+ *    frees everything at once (per-frame scratch), Mark()/Release() free back to a saved point.
+ *    An arena can also carve the chip into ranges for other arenas, pools, rings...
+ *  SRAMpool: blocks of one fixed size (records). Alloc() and Free() take the same short time
+ *    however many blocks there are: free blocks are chained through their first 3 bytes on the
+ *    chip, and blocks that were never used are handed out in order, so nothing is set up ahead.
+ *  Handles are chip addresses (24 bits, in a uint32_t): pass them straight to Write/Read.
+ *  SRAMnull means the allocation failed. Both keep only a few counters in MCU RAM.
+ *  Extends SRAMsimple, by David Dubins.
+ *  Released into the public domain.
+ */
+
+#ifndef SRAMalloc_h
+#define SRAMalloc_h
+
+#include <Arduino.h>
+#include "SRAMsimple.h"
+
+#define SRAMnull    0xFFFFFFUL  // handle returned when there is no room
+
+class SRAMarena {
+  public:
+    SRAMarena(uint32_t address=0, uint32_t size=SRAMsize);
+    uint32_t Alloc(uint32_t big, uint16_t align=1);
+    uint32_t Mark(){ return _top; }
+    void Release(uint32_t mark);
+    void Reset();
+    uint32_t Size(){ return _end-_start; }
+    uint32_t Used(){ return _top-_start; }
+    uint32_t Free(){ return _end-_top; }
+    uint32_t HighWater(){ return _highWater-_start; }
+    uint32_t Padding(){ return _padding; }
+    unsigned long Failures(){ return _failures; }
+  private:
+    uint32_t _start;        // first address of the arena
+    uint32_t _end;          // one past the last address
+    uint32_t _top;          // next free address
+    uint32_t _highWater;    // highest _top so far
+    uint32_t _padding;      // bytes skipped to align allocations since Reset()
+    unsigned long _failures;  // allocations that didn't fit
+};
+
+template<class Memory=SRAMsimple>
+class SRAMpool {
+  public:
+    SRAMpool(Memory &sram, uint32_t address, uint16_t blockSize, uint32_t blocks, bool pageAlign=false);
+    uint32_t Alloc();
+    bool Free(uint32_t handle);
+    void Reset();
+    uint16_t BlockSize(){ return _size; }
+    uint32_t Blocks(){ return _blocks; }
+    uint32_t InUse(){ return _inUse; }
+    uint32_t Available(){ return _blocks-_inUse; }
+    uint32_t HighWater(){ return _highWater; }
+    unsigned long Failures(){ return _failures; }
+  private:
+    void Link(uint32_t handle, uint32_t next);
+    uint32_t Next(uint32_t handle);
+    Memory &_sram;
+    uint32_t _start;        // address of block 0
+    uint16_t _size;         // bytes per block, after rounding up
+    uint32_t _blocks;       // blocks in the pool
+    uint32_t _carved;       // blocks handed out at least once: the rest have never been used
+    uint32_t _freeHead;     // first block of the free chain on the chip, or SRAMnull
+    uint32_t _inUse;
+    uint32_t _highWater;    // most blocks in use at once
+    unsigned long _failures;
+};
+
+/*  Blocks are at least 3 bytes (room for the free chain link). With pageAlign, the size is
+ *  rounded up to 4, 8, 16, 32 or a multiple of 32 and the first block starts on a page,
+ *  so no block straddles a 32-byte page. Make sure the range holds blocks*BlockSize() bytes */
+template<class Memory>
+SRAMpool<Memory>::SRAMpool(Memory &sram, uint32_t address, uint16_t blockSize, uint32_t blocks, bool pageAlign) : _sram(sram){
+  if(blockSize<3) blockSize=3;
+  if(pageAlign){
+    if(blockSize>SRAMpage) blockSize=(blockSize+SRAMpage-1)&~(SRAMpage-1);
+    else{
+      uint16_t s=4;
+      while(s<blockSize) s<<=1;
+      blockSize=s;
+    }
+    address=(address+SRAMpage-1)&~(uint32_t)(SRAMpage-1);
+  }
+  _start=address;
+  _size=blockSize;
+  _blocks=blocks;
+  Reset();
+}
+
+/*  Every block free again, counters back to 0 (nothing is written to the chip) **********/
+template<class Memory>
+void SRAMpool<Memory>::Reset(){
+  _carved=0;
+  _freeHead=SRAMnull;
+  _inUse=0;
+  _highWater=0;
+  _failures=0;
+}
+
+/*  The free chain: 3 bytes at the start of each free block, high byte first **********/
+template<class Memory>
+void SRAMpool<Memory>::Link(uint32_t handle, uint32_t next){
+  byte link[3]={(byte)(next>>16), (byte)(next>>8), (byte)next};
+  _sram.WriteArray(handle, link, 3);
+}
+
+template<class Memory>
+uint32_t SRAMpool<Memory>::Next(uint32_t handle){
+  byte link[3];
+  _sram.ReadArray(handle, link, 3);
+  return ((uint32_t)link[0]<<16)|((uint32_t)link[1]<<8)|link[2];
+}
+
+/*  A free block: the last one freed, or else one never used. SRAMnull if the pool is full **********/
+template<class Memory>
+uint32_t SRAMpool<Memory>::Alloc(){
+  uint32_t handle;
+  if(_freeHead!=SRAMnull){
+    handle=_freeHead;
+    _freeHead=Next(handle);                       // one 3-byte read
+  }else if(_carved<_blocks){
+    handle=_start+_carved*_size;                  // never used: no chip access at all
+    _carved++;
+  }else{
+    _failures++;
+    return SRAMnull;
+  }
+  _inUse++;
+  if(_inUse>_highWater) _highWater=_inUse;
+  return handle;
+}
+
+/*  Give a block back. Returns false for a handle that isn't a block of this pool.
+ *  Freeing the same block twice breaks the chain: don't **********/
+template<class Memory>
+bool SRAMpool<Memory>::Free(uint32_t handle){
+  if(handle<_start || handle>=_start+_carved*_size || (handle-_start)%_size!=0 || _inUse==0) return false;
+  Link(handle, _freeHead);                        // one 3-byte write
+  _freeHead=handle;
+  _inUse--;
+  return true;
+}
+
+#endif
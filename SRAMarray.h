@@ -0,0 +1,164 @@
+/*  SRAMarray.h - Array of values on a 23LC1024 (SRAMsimple or SRAMbank) that reads like a normal array.
+ *  SRAMarray<T, WINDOW> a(sram, address, size) holds size values of type T from address on.
+ *  a[i] reads and writes element i; for(float x : a), iterators and (off AVR) std algorithms work
+ *  too. A window of WINDOW elements is kept in MCU RAM: a[i] outside the window first writes back
+ *  the changed part of the window in one sequential transfer, then loads the WINDOW elements
+ *  starting at i (ending at i when walking backwards) in one more, so a loop over the array moves
+ *  whole blocks instead of one value per command. There is no prefetch in the background: the
+ *  next window is read when an element outside the current one is touched, and the loop waits
+ *  for that burst.
+ *  As with SRAMcache, call Flush() before touching the same addresses directly, and Invalidate()
+ *  after. Values are stored the same way SRAMsimple stores them. A size of 0 is taken as 1.
+ *  RAM used: WINDOW*sizeof(T) bytes, plus about 20.
+ *  Extends SRAMsimple, by David Dubins.
+ *  Released into the public domain.
+ */
+
+#ifndef SRAMarray_h
+#define SRAMarray_h
+
+#include <Arduino.h>
+#include "SRAMsimple.h"
+#if defined(__has_include)
+#if __has_include(<iterator>)
+#include <iterator>         // iterator_traits for std algorithms (not on AVR)
+#define SRAM_STD_ITERATOR
+#endif
+#endif
+
+#define ArrayNoWindow 0xFFFFFFFFUL  // no elements loaded
+
+template<class T, byte WINDOW=16, class Memory=SRAMsimple>
+class SRAMarray {
+  public:
+    class Ref;
+    class iterator;
+    SRAMarray(Memory &sram, uint32_t address, uint32_t size);
+    ~SRAMarray(){ Flush(); }
+    Ref operator[](uint32_t i){ return Ref(this, i); }
+    T Get(uint32_t i){ return _win[Load(i)]; }
+    void Set(uint32_t i, const T &value);
+    uint32_t Size(){ return _size; }
+    uint32_t Address(){ return _address; }
+    iterator begin(){ return iterator(this, 0); }
+    iterator end(){ return iterator(this, _size); }
+    void Flush();
+    void Invalidate();
+
+    /*  What a[i] returns: reads or writes element i when used as a T */
+    class Ref {
+      public:
+        Ref(SRAMarray *array, uint32_t i) : _a(array), _i(i){}
+        operator T() const { return _a->Get(_i); }
+        Ref &operator=(const T &value){ _a->Set(_i, value); return *this; }
+        Ref &operator=(const Ref &other){ _a->Set(_i, (T)other); return *this; }
+        Ref &operator+=(const T &value){ _a->Set(_i, _a->Get(_i)+value); return *this; }
+        Ref &operator-=(const T &value){ _a->Set(_i, _a->Get(_i)-value); return *this; }
+        Ref &operator*=(const T &value){ _a->Set(_i, _a->Get(_i)*value); return *this; }
+        Ref &operator/=(const T &value){ _a->Set(_i, _a->Get(_i)/value); return *this; }
+        friend void swap(Ref a, Ref b){ T t=a; a=(T)b; b=t; }
+      private:
+        SRAMarray *_a;
+        uint32_t _i;
+    };
+
+    class iterator {
+      public:
+#if defined(SRAM_STD_ITERATOR)
+        typedef std::random_access_iterator_tag iterator_category;
+#endif
+        typedef T value_type;
+        typedef long difference_type;
+        typedef Ref reference;
+        typedef Ref *pointer;
+        iterator() : _a(0), _i(0){}
+        iterator(SRAMarray *array, uint32_t i) : _a(array), _i(i){}
+        Ref operator*() const { return Ref(_a, _i); }
+        Ref operator[](long n) const { return Ref(_a, _i+n); }
+        iterator &operator++(){ _i++; return *this; }
+        iterator &operator--(){ _i--; return *this; }
+        iterator operator++(int){ iterator t=*this; _i++; return t; }
+        iterator operator--(int){ iterator t=*this; _i--; return t; }
+        iterator &operator+=(long n){ _i+=n; return *this; }
+        iterator &operator-=(long n){ _i-=n; return *this; }
+        iterator operator+(long n) const { return iterator(_a, _i+n); }
+        iterator operator-(long n) const { return iterator(_a, _i-n); }
+        friend iterator operator+(long n, const iterator &it){ return it+n; }
+        long operator-(const iterator &other) const { return (long)_i-(long)other._i; }
+        bool operator==(const iterator &other) const { return _i==other._i; }
+        bool operator!=(const iterator &other) const { return _i!=other._i; }
+        bool operator<(const iterator &other) const { return _i<other._i; }
+        bool operator>(const iterator &other) const { return _i>other._i; }
+        bool operator<=(const iterator &other) const { return _i<=other._i; }
+        bool operator>=(const iterator &other) const { return _i>=other._i; }
+      private:
+        SRAMarray *_a;
+        uint32_t _i;
+    };
+
+  private:
+    byte Load(uint32_t i);
+    Memory &_sram;
+    uint32_t _address;      // chip address of element 0
+    uint32_t _size;         // elements
+    T _win[WINDOW];         // elements _first to _first+_count-1
+    uint32_t _first;        // first element in the window, or ArrayNoWindow
+    byte _count;            // elements in the window (fewer than WINDOW at the end of a short array)
+    byte _lo, _hi;          // changed elements: window positions _lo to _hi-1 (_lo==_hi: none)
+};
+
+template<class T, byte WINDOW, class Memory>
+SRAMarray<T, WINDOW, Memory>::SRAMarray(Memory &sram, uint32_t address, uint32_t size) : _sram(sram){
+  _address=address;
+  _size=size ? size : 1;                         // Load() wraps indexes modulo the size
+  _first=ArrayNoWindow;
+  _count=0;
+  _lo=_hi=0;
+}
+
+/*  Window position of element i, moving the window if it isn't there **********/
+template<class T, byte WINDOW, class Memory>
+byte SRAMarray<T, WINDOW, Memory>::Load(uint32_t i){
+  if(_first!=ArrayNoWindow && i-_first<_count) return i-_first;   // hit (i<_first wraps to a big number)
+  if(i>=_size) i%=_size;                          // past the end wraps around, like chip addresses
+  bool back=(_first!=ArrayNoWindow && i+1==_first);  // walking backwards: keep i at the end
+  Flush();
+  uint32_t first=back ? ((i+1>WINDOW) ? i+1-WINDOW : 0) : i;
+  if(_size>WINDOW && first>_size-WINDOW) first=_size-WINDOW;  // stay inside the array
+  if(_size<=WINDOW) first=0;
+  _first=first;
+  _count=(_size-first<WINDOW) ? _size-first : WINDOW;
+  _sram.ReadArray(_address+first*sizeof(T), _win, _count);   // one burst
+  return i-_first;
+}
+
+template<class T, byte WINDOW, class Memory>
+void SRAMarray<T, WINDOW, Memory>::Set(uint32_t i, const T &value){
+  byte pos=Load(i);
+  _win[pos]=value;
+  if(_lo==_hi){                                   // first change in this window
+    _lo=pos;
+    _hi=pos+1;
+  }else{
+    if(pos<_lo) _lo=pos;
+    if(pos>=_hi) _hi=pos+1;
+  }
+}
+
+/*  Write the changed part of the window back, in one burst (the window stays loaded) **********/
+template<class T, byte WINDOW, class Memory>
+void SRAMarray<T, WINDOW, Memory>::Flush(){
+  if(_lo==_hi) return;
+  _sram.WriteArray(_address+(_first+_lo)*sizeof(T), _win+_lo, _hi-_lo);
+  _lo=_hi=0;
+}
+
+/*  Flush, then forget the window, so the next access reads the chip again **********/
+template<class T, byte WINDOW, class Memory>
+void SRAMarray<T, WINDOW, Memory>::Invalidate(){
+  Flush();
+  _first=ArrayNoWindow;
+  _count=0;
+}
+
+#endif
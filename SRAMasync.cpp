@@ -0,0 +1,183 @@
+/*  SRAMasync.cpp - Non-blocking byte array reads and writes for a 23LC1024 (SRAMsimple).
+ *  Extends SRAMsimple, by David Dubins.
+ *  Released into the public domain.
+ */
+
+#include "Arduino.h"
+#include "SRAMasync.h"
+
+SRAMasync *SRAMasync::_active=0;
+
+SRAMasync::SRAMasync(SRAMsimple &sram) : _sram(sram){
+  for(byte i=0; i<AsyncQueueSize; i++){
+    _req[i].state=AsyncFree;
+    _req[i].gen=0;
+  }
+  _head=_tail=_count=0;
+  _busy=false;
+  _phase=0;
+}
+
+/************ Queue a transfer ***************************/
+SRAMhandle SRAMasync::WriteAsync(uint32_t address, const byte *data, uint32_t big, SRAMcallback done){
+  return Queue(address, (byte *)data, big, true, done);   // data is only read from
+}
+
+SRAMhandle SRAMasync::ReadAsync(uint32_t address, byte *data, uint32_t big, SRAMcallback done){
+  return Queue(address, data, big, false, done);
+}
+
+SRAMhandle SRAMasync::Queue(uint32_t address, byte *data, uint32_t big, bool write, SRAMcallback done){
+  noInterrupts();
+  byte slot=_tail;
+  Request *r=&_req[slot];
+  if(_count>=AsyncQueueSize){                     // every slot is waiting or running
+    interrupts();
+    return AsyncNone;
+  }
+  r->address=address;
+  r->data=data;
+  r->big=big;
+  r->pos=0;
+  r->write=write;
+  r->done=done;
+  r->gen++;                                       // old handles for this slot now read as done
+  r->state=AsyncQueued;
+  _tail=(_tail+1)%AsyncQueueSize;
+  _count++;
+  SRAMhandle handle=((SRAMhandle)r->gen<<8)|slot;
+#if defined(__AVR__)
+  bool start=!_busy;                              // engine idle: we have to kick it off
+  if(start) _busy=true;
+  interrupts();
+  if(start){
+    _sram.UseMode(Sequential);                    // nothing else is on the bus, so this is safe
+    SPI.beginTransaction(_sram._settings);        // held until the queue is empty
+    _active=this;
+    noInterrupts();
+    Start();
+    interrupts();
+  }
+#else
+  interrupts();
+#endif
+  return handle;
+}
+
+/************ Where is a transfer up to ***************************/
+bool SRAMasync::Done(SRAMhandle handle){
+  if(handle==AsyncNone) return true;
+  Request *r=&_req[handle&0xFF];
+  if(r->gen!=(byte)(handle>>8)) return true;      // slot has been reused since: long finished
+  return r->state==AsyncDone;
+}
+
+void SRAMasync::Wait(SRAMhandle handle){
+  while(!Done(handle)) Poll();
+}
+
+bool SRAMasync::Busy(){
+  return _count>0;
+}
+
+#if defined(__AVR__)
+/************ AVR: the SPI interrupt moves one byte each time it fires ***************/
+
+/*  Pull CS low and send the command of the request at _head (interrupts off) **********/
+void SRAMasync::Start(){
+  Request *r=&_req[_head];
+  r->state=AsyncRunning;
+  _phase=0;
+  _sram.CSLow();
+  SPCR |= _BV(SPIE);                              // interrupt when each byte is done
+  SPDR = r->write ? WRITE : READ;
+}
+
+/*  Release CS, report the request done, and start the next one (interrupts off) **********/
+void SRAMasync::Finish(){
+  Request *r=&_req[_head];
+  _sram.CSHigh();
+  r->state=AsyncDone;
+  SRAMhandle handle=((SRAMhandle)r->gen<<8)|_head;
+  _head=(_head+1)%AsyncQueueSize;
+  _count--;
+  if(r->done) r->done(handle);
+  if(_count>0){
+    Start();                                      // same chip, same settings: keep the transaction
+  }else{
+    SPCR &= ~_BV(SPIE);
+    SPI.endTransaction();
+    _busy=false;
+  }
+}
+
+void SRAMasync::Interrupt(){
+  SRAMasync *e=_active;
+  byte in=SPDR;                                   // byte that came back with the one just sent
+  Request *r=&e->_req[e->_head];
+  if(e->_phase<3){                                // command or address byte done: next address byte
+    SPDR=(byte)(r->address >> (16-8*e->_phase));
+    e->_phase++;
+    return;
+  }
+  if(e->_phase==3){                               // address done: first data byte
+    e->_phase=4;
+    if(r->big==0){
+      e->Finish();
+      return;
+    }
+    SPDR = r->write ? r->data[0] : 0x00;
+    return;
+  }
+  if(!r->write) r->data[r->pos]=in;               // data byte done
+  r->pos++;
+  if(r->pos<r->big){
+    SPDR = r->write ? r->data[r->pos] : 0x00;
+    return;
+  }
+  e->Finish();
+}
+
+void SRAMasync::Poll(){
+  /* the interrupt does all the work */
+}
+
+#else
+/************ Other boards: Poll() moves the next chunk ***************/
+
+void SRAMasync::Start(){
+  Request *r=&_req[_head];
+  r->state=AsyncRunning;
+  if(r->write) _sram.BeginWrite(r->address);
+  else _sram.BeginRead(r->address);
+}
+
+void SRAMasync::Finish(){
+  Request *r=&_req[_head];
+  _sram.End();
+  r->state=AsyncDone;
+  SRAMhandle handle=((SRAMhandle)r->gen<<8)|_head;
+  _head=(_head+1)%AsyncQueueSize;
+  _count--;
+  if(r->done) r->done(handle);
+}
+
+void SRAMasync::Poll(){
+  if(_count==0) return;
+  Request *r=&_req[_head];
+  if(r->state==AsyncQueued) Start();
+  uint32_t n=r->big-r->pos;
+  if(n>AsyncChunk) n=AsyncChunk;
+  for(uint32_t i=0; i<n; i++){
+    if(r->write) _sram.Send(r->data[r->pos]);
+    else r->data[r->pos]=_sram.Receive();
+    r->pos++;
+  }
+  if(r->pos>=r->big) Finish();
+}
+
+void SRAMasync::Interrupt(){
+  /* no interrupt engine on this board */
+}
+
+#endif
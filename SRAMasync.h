@@ -0,0 +1,77 @@
+/*  SRAMasync.h - Non-blocking byte array reads and writes for a 23LC1024 (SRAMsimple).
+ *  WriteAsync and ReadAsync queue a transfer and return a handle right away; the sketch keeps
+ *  running while the bytes move. Check Done(handle), call Wait(handle), or pass a callback.
+ *  On AVR the SPI interrupt feeds SPDR one byte at a time, so transfers run in the background.
+ *  Other boards (and the host build) move AsyncChunk bytes each time Poll() is called from
+ *  loop(), so the sketch still gets to work between chunks.
+ *  Nothing else may use the SPI bus while Busy() is true: no SRAMsimple calls, no other devices.
+ *  The AVR engine drives the SPI hardware itself, so it can't be used after SetBus().
+ *  Callbacks run inside the SPI interrupt on AVR: keep them short (set a flag).
+ *  On AVR the sketch has to hand the SPI interrupt to SRAMasync, by putting this line once at the
+ *  top level of the sketch (it does nothing on other boards):
+ *    SRAMASYNC_DEFINE_ISR()
+ *  The library doesn't define the interrupt itself, so sketches that don't use SRAMasync keep
+ *  the SPI interrupt free for other code.
+ *  Extends SRAMsimple, by David Dubins.
+ *  Released into the public domain.
+ */
+
+#ifndef SRAMasync_h
+#define SRAMasync_h
+
+#include <Arduino.h>
+#include "SRAMsimple.h"
+
+#define AsyncQueueSize 4        // transfers that can be waiting at once
+#define AsyncChunk     32       // bytes moved per Poll() on boards without the interrupt engine
+#define AsyncNone      0xFFFF   // handle returned when the queue is full
+
+#define AsyncFree      0        // request slot states
+#define AsyncQueued    1
+#define AsyncRunning   2
+#define AsyncDone      3
+
+#if defined(__AVR__)
+#define SRAMASYNC_DEFINE_ISR()  ISR(SPI_STC_vect){ SRAMasync::Interrupt(); }
+#else
+#define SRAMASYNC_DEFINE_ISR()
+#endif
+
+typedef uint16_t SRAMhandle;                    // request slot (low byte) and generation (high byte)
+typedef void (*SRAMcallback)(SRAMhandle handle);
+
+class SRAMasync {
+  public:
+    SRAMasync(SRAMsimple &sram);
+    SRAMhandle WriteAsync(uint32_t address, const byte *data, uint32_t big, SRAMcallback done=0);
+    SRAMhandle ReadAsync(uint32_t address, byte *data, uint32_t big, SRAMcallback done=0);
+    bool Done(SRAMhandle handle);
+    void Wait(SRAMhandle handle);
+    bool Busy();
+    void Poll();
+    static void Interrupt();
+  private:
+    struct Request {
+      uint32_t address;
+      byte *data;
+      uint32_t big;
+      uint32_t pos;           // bytes moved so far
+      bool write;
+      SRAMcallback done;
+      volatile byte state;    // AsyncFree, AsyncQueued, AsyncRunning or AsyncDone
+      byte gen;               // bumped each time the slot is reused
+    };
+    SRAMhandle Queue(uint32_t address, byte *data, uint32_t big, bool write, SRAMcallback done);
+    void Start();
+    void Finish();
+    SRAMsimple &_sram;
+    Request _req[AsyncQueueSize];   // ring of requests, in the order they were queued
+    volatile byte _head;            // request being transferred
+    volatile byte _tail;            // where the next request goes
+    volatile byte _count;           // requests queued or running
+    volatile bool _busy;            // AVR: interrupt engine owns the bus
+    volatile byte _phase;           // AVR: 0-2 address bytes, 3 address done, 4 data
+    static SRAMasync *_active;      // engine the SPI interrupt works for
+};
+
+#endif
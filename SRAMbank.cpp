@@ -0,0 +1,181 @@
+/*  SRAMbank.cpp - Several 23LC1024 chips on one SPI bus, addressed as one linear memory space.
+ *  Extends SRAMsimple, by David Dubins.
+ *  Released into the public domain.
+ */
+
+#include "Arduino.h"
+#include "SRAMbank.h"
+
+SRAMbank::SRAMbank(SRAMsimple *chips, byte count){
+  _chips=chips;                                   // chips are owned by the sketch
+  _count=count ? count : 1;                       // Wrap() divides by the size: at least one chip
+  _chip=0;
+  _room=0;
+  _writing=false;
+}
+
+/*  Total number of bytes in the bank **********/
+uint32_t SRAMbank::Size(){
+  return SRAMsize*_count;
+}
+
+/*  Addresses past the end of the bank wrap back to 0, same as a single chip does **********/
+uint32_t SRAMbank::Wrap(uint32_t address){
+  return address%Size();
+}
+
+/*  Which chip holds this address **********/
+SRAMsimple &SRAMbank::Chip(uint32_t address){
+  return _chips[Wrap(address)/SRAMsize];
+}
+
+/************ Byte transfer functions ***************************/
+void SRAMbank::WriteByte(uint32_t address, byte data_byte){
+  address=Wrap(address);
+  _chips[address/SRAMsize].WriteByte(address%SRAMsize, data_byte);
+}
+
+byte SRAMbank::ReadByte(uint32_t address){
+  address=Wrap(address);
+  return _chips[address/SRAMsize].ReadByte(address%SRAMsize);
+}
+
+/*********** Sequential transfers: split where the data crosses from one chip to the next ****/
+void SRAMbank::WriteByteArray(uint32_t address, byte *data, uint32_t big){
+  while(big>0){
+    address=Wrap(address);
+    uint32_t offset=address%SRAMsize;             // address inside this chip
+    uint32_t room=SRAMsize-offset;                // bytes left before the next chip
+    uint32_t n=(big<room)?big:room;
+    _chips[address/SRAMsize].WriteByteArray(offset, data, n);
+    address+=n;                                   // carry on at the start of the next chip
+    data+=n;
+    big-=n;
+  }
+}
+
+void SRAMbank::ReadByteArray(uint32_t address, byte *data, uint32_t big){
+  while(big>0){
+    address=Wrap(address);
+    uint32_t offset=address%SRAMsize;             // address inside this chip
+    uint32_t room=SRAMsize-offset;                // bytes left before the next chip
+    uint32_t n=(big<room)?big:room;
+    _chips[address/SRAMsize].ReadByteArray(offset, data, n);
+    address+=n;                                   // carry on at the start of the next chip
+    data+=n;
+    big-=n;
+  }
+}
+
+/************ Sequential transactions that carry on across chip boundaries ***************/
+void SRAMbank::Begin(uint32_t address, bool write){
+  address=Wrap(address);
+  _chip=address/SRAMsize;
+  _room=SRAMsize-address%SRAMsize;                // bytes before the next chip
+  _writing=write;
+  if(write) _chips[_chip].BeginWrite(address%SRAMsize);
+  else _chips[_chip].BeginRead(address%SRAMsize);
+}
+
+/*  End the transaction on this chip, and open one at address 0 of the next chip **********/
+void SRAMbank::NextChip(){
+  _chips[_chip].End();
+  Begin((uint32_t)(_chip+1)*SRAMsize, _writing);  // wraps to chip 0 past the last chip
+}
+
+void SRAMbank::BeginWrite(uint32_t address){
+  Begin(address, true);
+}
+
+void SRAMbank::BeginRead(uint32_t address){
+  Begin(address, false);
+}
+
+void SRAMbank::Send(byte data){
+  if(_room==0) NextChip();
+  _chips[_chip].Send(data);
+  _room--;
+}
+
+byte SRAMbank::Receive(){
+  if(_room==0) NextChip();
+  _room--;
+  return _chips[_chip].Receive();
+}
+
+void SRAMbank::End(){
+  _chips[_chip].End();
+}
+
+/************ Stream a block (default: the whole bank) out to a Print, and back in from a Stream ****/
+void SRAMbank::Dump(Print &out){
+  Dump(out, 0, Size());
+}
+
+void SRAMbank::Dump(Print &out, uint32_t address, uint32_t big){
+  byte temp[32];                                  // a page at a time, so Print can send it in one go
+  BeginRead(address);
+  while(big>0){
+    byte n=(big<sizeof(temp))?big:sizeof(temp);
+    for(byte i=0; i<n; i++) temp[i]=Receive();
+    out.write(temp, n);
+    big-=n;
+  }
+  End();
+}
+
+uint32_t SRAMbank::Restore(Stream &in){
+  return Restore(in, 0, Size());
+}
+
+/*  Returns the number of bytes written: less than big if the Stream timed out **********/
+uint32_t SRAMbank::Restore(Stream &in, uint32_t address, uint32_t big){
+  byte temp[32];                                  // a page at a time
+  uint32_t done=0;
+  BeginWrite(address);
+  while(done<big){
+    byte n=(big-done<sizeof(temp))?(big-done):sizeof(temp);
+    byte got=in.readBytes(temp, n);               // waits up to the Stream timeout
+    for(byte i=0; i<got; i++) Send(temp[i]);
+    done+=got;
+    if(got<n) break;                              // nothing more coming
+  }
+  End();
+  return done;
+}
+
+/************ Bulk operations, across chip boundaries ***************************/
+void SRAMbank::Fill(uint32_t address, byte value, uint32_t big){
+  BeginWrite(address);
+  for(uint32_t i=0; i<big; i++) Send(value);
+  End();
+}
+
+/*  Copy big bytes, a page at a time; overlapping blocks are handled like memmove **********/
+void SRAMbank::Copy(uint32_t from, uint32_t to, uint32_t big){
+  byte temp[SRAMpage];
+  uint32_t ahead=(Wrap(to)+Size()-Wrap(from))%Size();  // how far the destination is past the source, around the bank
+  if(ahead==0) return;
+  bool back=(ahead<big);
+  uint32_t done=0;
+  while(done<big){
+    byte n=(big-done<sizeof(temp))?(big-done):sizeof(temp);
+    uint32_t offset=back ? big-done-n : done;
+    ReadByteArray(from+offset, temp, n);          // these split the page if it crosses to the next chip
+    WriteByteArray(to+offset, temp, n);
+    done+=n;
+  }
+}
+
+bool SRAMbank::Compare(uint32_t address, const byte *data, uint32_t big){
+  bool same=true;
+  BeginRead(address);
+  for(uint32_t i=0; i<big; i++){
+    if(Receive()!=data[i]){
+      same=false;
+      break;
+    }
+  }
+  End();
+  return same;
+}
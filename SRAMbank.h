@@ -0,0 +1,76 @@
+/*  SRAMbank.h - Several 23LC1024 chips on one SPI bus, addressed as one linear memory space.
+ *  Chip 0 holds addresses 0 to 0x1FFFF, chip 1 holds 0x20000 to 0x3FFFF, and so on.
+ *  A bank has at least one chip: a count of 0 is taken as 1.
+ *  Extends SRAMsimple, by David Dubins.
+ *  Released into the public domain.
+ */
+
+#ifndef SRAMbank_h
+#define SRAMbank_h
+
+#include <Arduino.h>
+#include "SRAMsimple.h"
+
+class SRAMbank {
+  public:
+    SRAMbank(SRAMsimple *chips, byte count);
+    uint32_t Size();
+    SRAMsimple &Chip(uint32_t address);
+    void WriteByte(uint32_t address, byte data_byte);
+    byte ReadByte(uint32_t address);
+    void WriteByteArray(uint32_t address, byte *data, uint32_t big);
+    void ReadByteArray(uint32_t address, byte *data, uint32_t big);
+    void BeginWrite(uint32_t address);
+    void BeginRead(uint32_t address);
+    void Send(byte data);
+    byte Receive();
+    void End();
+    void Dump(Print &out);
+    void Dump(Print &out, uint32_t address, uint32_t big);
+    uint32_t Restore(Stream &in);
+    uint32_t Restore(Stream &in, uint32_t address, uint32_t big);
+    void Fill(uint32_t address, byte value, uint32_t big);
+    void Copy(uint32_t from, uint32_t to, uint32_t big);
+    bool Compare(uint32_t address, const byte *data, uint32_t big);
+    template<class T> void Write(uint32_t address, const T &data);
+    template<class T> void Read(uint32_t address, T &data);
+    template<class T> T Read(uint32_t address){ T data; Read(address, data); return data; }
+    template<class T> void WriteArray(uint32_t address, const T *data, uint32_t big);
+    template<class T> void ReadArray(uint32_t address, T *data, uint32_t big);
+  private:
+    uint32_t Wrap(uint32_t address);
+    void Begin(uint32_t address, bool write);
+    void NextChip();
+    SRAMsimple *_chips;     // array of chips, one per CS pin, in address order
+    byte _count;            // number of chips in the array
+    byte _chip;             // chip the open transaction is on
+    uint32_t _room;         // bytes left on that chip before we have to move to the next one
+    bool _writing;          // open transaction is a write
+};
+
+/************ Any type: values that straddle two chips are split between them *********/
+template<class T> void SRAMbank::Write(uint32_t address, const T &data){
+  BeginWrite(address);
+  SRAMsend(*this, data);
+  End();
+}
+
+template<class T> void SRAMbank::Read(uint32_t address, T &data){
+  BeginRead(address);
+  SRAMreceive(*this, data);
+  End();
+}
+
+template<class T> void SRAMbank::WriteArray(uint32_t address, const T *data, uint32_t big){
+  BeginWrite(address);
+  for(uint32_t i=0; i<big; i++) SRAMsend(*this, data[i]);
+  End();
+}
+
+template<class T> void SRAMbank::ReadArray(uint32_t address, T *data, uint32_t big){
+  BeginRead(address);
+  for(uint32_t i=0; i<big; i++) SRAMreceive(*this, data[i]);
+  End();
+}
+
+#endif
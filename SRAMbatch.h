@@ -0,0 +1,121 @@
+/*  SRAMbatch.h - Collect many small reads and writes on a 23LC1024 (SRAMsimple or SRAMbank),
+ *  then run them with as few commands as possible.
+ *  Each Read/Write only records the address and where the data is in RAM. Run() sorts them by
+ *  address and joins neighbours into one sequential transfer: reads that are at most Gap bytes
+ *  apart (the bytes in between are clocked in and dropped), and writes that follow each other
+ *  exactly. Every write runs before every read, so reads see what the batch wrote; if two
+ *  writes overlap, the one recorded last wins.
+ *  Data is stored the same way as SRAMsimple stores it, so the two can be mixed freely.
+ *  The variables must stay in place until Run() returns: read values arrive during Run().
+ *  RAM used: SIZE*16 bytes or so (default 16 entries).
+ *  Extends SRAMsimple, by David Dubins.
+ *  Released into the public domain.
+ */
+
+#ifndef SRAMbatch_h
+#define SRAMbatch_h
+
+#include <Arduino.h>
+#include "SRAMsimple.h"
+
+#define BatchGap    4       // default: a new command costs 4 bytes, so skipping up to 4 is never slower
+
+template<byte SIZE=16, class Memory=SRAMsimple>
+class SRAMbatch {
+  public:
+    SRAMbatch(Memory &sram, uint16_t gap=BatchGap) : _sram(sram){ _gap=gap; _count=0; }
+    template<class T> bool Write(uint32_t address, const T &data){ return Add(address, (byte *)&data, 1, sizeof(T), true, Move<T>); }
+    template<class T> bool Read(uint32_t address, T &data){ return Add(address, (byte *)&data, 1, sizeof(T), false, Move<T>); }
+    template<class T> bool WriteArray(uint32_t address, const T *data, uint32_t big){ return Add(address, (byte *)data, big, sizeof(T), true, Move<T>); }
+    template<class T> bool ReadArray(uint32_t address, T *data, uint32_t big){ return Add(address, (byte *)data, big, sizeof(T), false, Move<T>); }
+    template<class T> bool Write(uint32_t address, const T &&data)=delete;   // a temporary would be gone before Run()
+    byte Run();
+    void Clear(){ _count=0; }
+    byte Count(){ return _count; }
+    void SetGap(uint16_t gap){ _gap=gap; }
+  private:
+    typedef void (*Mover)(Memory &sram, byte *data, uint32_t big, bool write);
+    struct Entry {
+      uint32_t address;
+      uint32_t bytes;         // on the chip: elements * element size
+      byte *data;
+      uint32_t big;           // elements
+      bool write;
+      Mover move;             // sends or receives the elements, in chip byte order
+    };
+    template<class T> static void Move(Memory &sram, byte *data, uint32_t big, bool write);
+    bool Add(uint32_t address, byte *data, uint32_t big, size_t size, bool write, Mover move);
+    bool Before(const Entry &a, const Entry &b);
+    Memory &_sram;
+    Entry _entry[SIZE];
+    byte _count;
+    uint16_t _gap;          // most bytes a read may skip to stay in the same transfer
+};
+
+/*  Elements of type T, encoded or decoded on the way like SRAMsimple::WriteArray/ReadArray **********/
+template<byte SIZE, class Memory> template<class T>
+void SRAMbatch<SIZE, Memory>::Move(Memory &sram, byte *data, uint32_t big, bool write){
+  T *values=(T *)data;
+  for(uint32_t i=0; i<big; i++){
+    if(write) SRAMsend(sram, values[i]);
+    else SRAMreceive(sram, values[i]);
+  }
+}
+
+/*  Returns false if the batch is full (Run() it, then add the rest) **********/
+template<byte SIZE, class Memory>
+bool SRAMbatch<SIZE, Memory>::Add(uint32_t address, byte *data, uint32_t big, size_t size, bool write, Mover move){
+  if(_count>=SIZE) return false;
+  Entry &e=_entry[_count++];
+  e.address=address;
+  e.bytes=big*size;
+  e.data=data;
+  e.big=big;
+  e.write=write;
+  e.move=move;
+  return true;
+}
+
+/*  Run order: writes first, then by address. Overlapping writes keep the order they were recorded in */
+template<byte SIZE, class Memory>
+bool SRAMbatch<SIZE, Memory>::Before(const Entry &a, const Entry &b){
+  if(a.write!=b.write) return a.write;
+  if(a.write && a.address<b.address+b.bytes && b.address<a.address+a.bytes) return false;
+  return a.address<b.address;
+}
+
+/*  Sort, join and run everything recorded, then empty the batch. Returns the number of commands sent */
+template<byte SIZE, class Memory>
+byte SRAMbatch<SIZE, Memory>::Run(){
+  for(byte i=1; i<_count; i++){                   // insertion sort: a handful of entries, mostly in order
+    Entry e=_entry[i];
+    byte j=i;
+    while(j>0 && Before(e, _entry[j-1])){
+      _entry[j]=_entry[j-1];
+      j--;
+    }
+    _entry[j]=e;
+  }
+  byte commands=0;
+  byte i=0;
+  while(i<_count){
+    Entry &first=_entry[i];
+    if(first.write) _sram.BeginWrite(first.address);
+    else _sram.BeginRead(first.address);
+    commands++;
+    uint32_t next=first.address;                  // chip address the transfer has reached
+    do{
+      Entry &e=_entry[i];
+      for(; next<e.address; next++) _sram.Receive();  // read gap: clock the bytes in and drop them
+      e.move(_sram, e.data, e.big, e.write);
+      next+=e.bytes;
+      i++;
+    }while(i<_count && _entry[i].write==first.write && _entry[i].address>=next &&
+           _entry[i].address-next<=(first.write ? 0 : _gap));
+    _sram.End();
+  }
+  _count=0;
+  return commands;
+}
+
+#endif
@@ -0,0 +1,24 @@
+/*  SRAMbus.h - Interface for the wires between SRAMsimple and a 23LC1024.
+ *  By default SRAMsimple talks to the chip through the hardware SPI library. Give it an
+ *  SRAMbus with SetBus() (for example an SRAMquad) to use other pins or a wider bus instead.
+ *  Chip select stays with SRAMsimple; the bus only moves bytes.
+ *  Extends SRAMsimple, by David Dubins.
+ *  Released into the public domain.
+ */
+
+#ifndef SRAMbus_h
+#define SRAMbus_h
+
+#include <Arduino.h>
+
+class SRAMbus {
+  public:
+    virtual void Attach()=0;            // set up the pins (called once by SetBus)
+    virtual void Reset()=0;             // CS low: put the chip back in SPI mode, whatever mode it is in (RSTIO)
+    virtual void Enter()=0;             // CS low: send EDIO/EQIO one bit wide, if the bus is wider than SPI
+    virtual void Send(byte data)=0;     // CS low: clock one byte out to the chip
+    virtual byte Receive()=0;           // CS low: clock one byte in from the chip
+    virtual byte Dummies()=0;           // dummy bytes between a READ address and the data
+};
+
+#endif
@@ -0,0 +1,147 @@
+/*  SRAMcache.h - Write-back cache in MCU RAM in front of a 23LC1024 (SRAMsimple or SRAMbank).
+ *  Holds LINES lines of LINE bytes each (default: 4 lines of 32 bytes, the 23LC1024 page size).
+ *  Hits are served from RAM. A miss loads the whole line with one sequential read, and a dirty
+ *  line is written back with one sequential write when it is evicted, or on Flush().
+ *  Everything must go through the cache while it is in use: call Flush() before touching the
+ *  chip directly, and Invalidate() after, or the two will disagree.
+ *  RAM used: LINES*(LINE+6) bytes, plus a few counters.
+ *  Extends SRAMsimple, by David Dubins.
+ *  Released into the public domain.
+ */
+
+#ifndef SRAMcache_h
+#define SRAMcache_h
+
+#include <Arduino.h>
+#include "SRAMsimple.h"
+
+#define CacheNoLine 0xFFFFFFFFUL    // tag of an empty cache line
+
+template<byte LINES=4, byte LINE=32, class Memory=SRAMsimple>
+class SRAMcache {
+  public:
+    SRAMcache(Memory &sram);
+    template<class T> void Write(uint32_t address, const T &data);
+    template<class T> void Read(uint32_t address, T &data);
+    template<class T> T Read(uint32_t address){ T data; Read(address, data); return data; }
+    void WriteBytes(uint32_t address, const byte *data, uint32_t big);
+    void ReadBytes(uint32_t address, byte *data, uint32_t big);
+    void Flush();
+    void Invalidate();
+    unsigned long Hits(){ return _hits; }
+    unsigned long Misses(){ return _misses; }
+    unsigned long WriteBacks(){ return _writeBacks; }
+    void ResetCounters(){ _hits=_misses=_writeBacks=0; }
+  private:
+    byte Line(uint32_t tag, bool fill);
+    void Evict(byte line);
+    Memory &_sram;
+    byte _data[LINES][LINE];    // cached bytes
+    uint32_t _tag[LINES];       // address/LINE of each line, or CacheNoLine
+    bool _dirty[LINES];         // line changed since it was loaded
+    byte _order[LINES];         // line numbers, most recently used first
+    unsigned long _hits;
+    unsigned long _misses;
+    unsigned long _writeBacks;
+};
+
+template<byte LINES, byte LINE, class Memory>
+SRAMcache<LINES, LINE, Memory>::SRAMcache(Memory &sram) : _sram(sram){
+  for(byte i=0; i<LINES; i++){
+    _tag[i]=CacheNoLine;
+    _dirty[i]=false;
+    _order[i]=i;
+  }
+  ResetCounters();
+}
+
+/*  Write a dirty line back with one sequential transfer **********/
+template<byte LINES, byte LINE, class Memory>
+void SRAMcache<LINES, LINE, Memory>::Evict(byte line){
+  if(_tag[line]!=CacheNoLine && _dirty[line]){
+    _sram.WriteArray(_tag[line]*LINE, _data[line], LINE);
+    _writeBacks++;
+  }
+  _dirty[line]=false;
+}
+
+/*  Find the line holding this tag, loading it if it isn't cached (fill=false: caller is
+ *  about to overwrite the whole line, so there is no need to read it first) **********/
+template<byte LINES, byte LINE, class Memory>
+byte SRAMcache<LINES, LINE, Memory>::Line(uint32_t tag, bool fill){
+  byte pos=0;
+  while(pos<LINES && _tag[_order[pos]]!=tag) pos++;
+  if(pos<LINES){
+    _hits++;
+  }else{
+    _misses++;
+    pos=LINES-1;                                  // least recently used line goes
+    byte line=_order[pos];
+    Evict(line);
+    if(fill) _sram.ReadArray(tag*LINE, _data[line], LINE);
+    _tag[line]=tag;
+  }
+  byte line=_order[pos];
+  for(; pos>0; pos--) _order[pos]=_order[pos-1];  // move to the front
+  _order[0]=line;
+  return line;
+}
+
+template<byte LINES, byte LINE, class Memory>
+void SRAMcache<LINES, LINE, Memory>::WriteBytes(uint32_t address, const byte *data, uint32_t big){
+  while(big>0){
+    uint16_t offset=address%LINE;
+    uint32_t n=LINE-offset;                       // bytes left in this line
+    if(n>big) n=big;
+    byte line=Line(address/LINE, n<LINE);         // a whole line is overwritten: don't read it
+    memcpy(&_data[line][offset], data, n);
+    _dirty[line]=true;
+    address+=n;
+    data+=n;
+    big-=n;
+  }
+}
+
+template<byte LINES, byte LINE, class Memory>
+void SRAMcache<LINES, LINE, Memory>::ReadBytes(uint32_t address, byte *data, uint32_t big){
+  while(big>0){
+    uint16_t offset=address%LINE;
+    uint32_t n=LINE-offset;                       // bytes left in this line
+    if(n>big) n=big;
+    byte line=Line(address/LINE, true);
+    memcpy(data, &_data[line][offset], n);
+    address+=n;
+    data+=n;
+    big-=n;
+  }
+}
+
+/************ Any type, in the same byte order as SRAMsimple uses ***************/
+template<byte LINES, byte LINE, class Memory> template<class T>
+void SRAMcache<LINES, LINE, Memory>::Write(uint32_t address, const T &data){
+  byte temp[sizeof(T)];
+  SRAMencode(data, temp);
+  WriteBytes(address, temp, sizeof(T));
+}
+
+template<byte LINES, byte LINE, class Memory> template<class T>
+void SRAMcache<LINES, LINE, Memory>::Read(uint32_t address, T &data){
+  byte temp[sizeof(T)];
+  ReadBytes(address, temp, sizeof(T));
+  SRAMdecode(temp, data);
+}
+
+/*  Write every dirty line back to the chip (lines stay cached) **********/
+template<byte LINES, byte LINE, class Memory>
+void SRAMcache<LINES, LINE, Memory>::Flush(){
+  for(byte i=0; i<LINES; i++) Evict(i);
+}
+
+/*  Flush, then forget everything, so the next reads come from the chip **********/
+template<byte LINES, byte LINE, class Memory>
+void SRAMcache<LINES, LINE, Memory>::Invalidate(){
+  Flush();
+  for(byte i=0; i<LINES; i++) _tag[i]=CacheNoLine;
+}
+
+#endif
@@ -0,0 +1,75 @@
+/*  SRAMcheck.h - Blocks on a 23LC1024 (SRAMsimple or SRAMbank) stored with a CRC, so damage is noticed.
+ *  SRAMcheck<> check(sram) writes and reads arrays (or single values) like SRAMsimple does, but
+ *  WriteArray also stores a CRC of the block right after it, and ReadArray returns false if the
+ *  data it read no longer matches that CRC (a brown-out, a noisy line, or something else writing
+ *  there). The CRC is worked out byte by byte while the data goes over the bus, from a table in
+ *  flash, so checking costs the CRC bytes on the bus and a table lookup per byte, not a second pass.
+ *    SRAMcheck<> check(sram);              // CRC-16/CCITT-FALSE: 2 bytes per block
+ *    SRAMcheck<uint32_t> check32(sram);    // CRC-32 (as in zip): 4 bytes per block, for big blocks
+ *  A block takes Bytes<T>(big) bytes on the chip: the data, then the CRC, high byte first.
+ *  On a failed read the data has still been copied into the array: don't use it.
+ *  Extends SRAMsimple, by David Dubins.
+ *  Released into the public domain.
+ */
+
+#ifndef SRAMcheck_h
+#define SRAMcheck_h
+
+#include <Arduino.h>
+#include "SRAMsimple.h"
+
+/************ Table-driven CRCs (tables in SRAMcheck.cpp, only linked in if used) ******************
+ * Start from all ones, add each byte with SRAMcrc(), and finish with SRAMcrcEnd().
+ */
+uint16_t SRAMcrc(uint16_t crc, byte data);          // CRC-16/CCITT-FALSE
+uint32_t SRAMcrc(uint32_t crc, byte data);          // CRC-32
+inline uint16_t SRAMcrcEnd(uint16_t crc){ return crc; }
+inline uint32_t SRAMcrcEnd(uint32_t crc){ return ~crc; }
+
+template<class CRC=uint16_t, class Memory=SRAMsimple>
+class SRAMcheck {
+  public:
+    SRAMcheck(Memory &sram) : _sram(sram){ _errors=0; }
+    template<class T> void Write(uint32_t address, const T &data){ WriteArray(address, &data, 1); }
+    template<class T> bool Read(uint32_t address, T &data){ return ReadArray(address, &data, 1); }
+    template<class T> void WriteArray(uint32_t address, const T *data, uint32_t big);
+    template<class T> bool ReadArray(uint32_t address, T *data, uint32_t big);
+    template<class T> static uint32_t Bytes(uint32_t big){ return big*sizeof(T)+sizeof(CRC); }
+    uint32_t Errors(){ return _errors; }
+    void ClearErrors(){ _errors=0; }
+  private:
+    struct Summer {         // passes bytes to and from the chip, adding each one to the CRC
+      Memory &sram;
+      CRC crc;
+      void Send(byte data){ sram.Send(data); crc=SRAMcrc(crc, data); }
+      byte Receive(){ byte data=sram.Receive(); crc=SRAMcrc(crc, data); return data; }
+    };
+    Memory &_sram;
+    uint32_t _errors;       // reads that failed their CRC
+};
+
+/*  The block, then its CRC, in one sequential write **********/
+template<class CRC, class Memory> template<class T>
+void SRAMcheck<CRC, Memory>::WriteArray(uint32_t address, const T *data, uint32_t big){
+  Summer bus={_sram, (CRC)~(CRC)0};
+  _sram.BeginWrite(address);
+  for(uint32_t i=0; i<big; i++) SRAMsend(bus, data[i]);
+  SRAMsend(_sram, SRAMcrcEnd(bus.crc));
+  _sram.End();
+}
+
+/*  Returns false if the CRC stored after the block doesn't match what was read **********/
+template<class CRC, class Memory> template<class T>
+bool SRAMcheck<CRC, Memory>::ReadArray(uint32_t address, T *data, uint32_t big){
+  Summer bus={_sram, (CRC)~(CRC)0};
+  CRC stored;
+  _sram.BeginRead(address);
+  for(uint32_t i=0; i<big; i++) SRAMreceive(bus, data[i]);
+  SRAMreceive(_sram, stored);
+  _sram.End();
+  if(stored==SRAMcrcEnd(bus.crc)) return true;
+  _errors++;
+  return false;
+}
+
+#endif
@@ -0,0 +1,218 @@
+/*  SRAMpack.h - Integer samples stored packed on a 23LC1024 (SRAMsimple or SRAMbank), 2-4x smaller.
+ *  Sensor readings usually change little from one sample to the next. SRAMpack stores the first
+ *  value, then only the differences, zig-zag coded (0, -1, 1, -2, 2, ... become 0, 1, 2, 3, 4, ...)
+ *  and bit-packed 8 at a time: a width byte, then 8 differences of that many bits. Samples that
+ *  move by less than +-8 take 4 bits each plus 1 byte per 8, instead of 16 bits, so both the
+ *  space on the chip and the bytes on the bus shrink. Noisy or jumpy data packs less well: the
+ *  worst case is a little more than the raw size (MaxBytes()).
+ *  Packing and unpacking happen on the fly, 8 samples at a time, with no buffer.
+ *    SRAMpack<> pack(sram, address, size);     // a log of packed blocks in size bytes from address
+ *    pack.Append(samples, 256);                // pack a block of 256 ints onto the end of the log
+ *    pack.Read(1000, values, 10);              // samples 1000 to 1009, from any block
+ *  The index keeps where each of the BLOCKS blocks starts, so Read() only unpacks from the start
+ *  of the block holding the first sample asked for: shorter blocks mean faster random access.
+ *  WriteArray/ReadArray pack and unpack a single array at any address, without the index.
+ *  Works with any integer type up to 32 bits (int, long, unsigned int, ...); wider ones don't compile.
+ *  RAM used: BLOCKS*8 bytes, plus about 20.
+ *  Extends SRAMsimple, by David Dubins.
+ *  Released into the public domain.
+ */
+
+#ifndef SRAMpack_h
+#define SRAMpack_h
+
+#include <Arduino.h>
+#include "SRAMsimple.h"
+
+template<byte BLOCKS=16, class Memory=SRAMsimple>
+class SRAMpack {
+  public:
+    SRAMpack(Memory &sram, uint32_t address, uint32_t size) : _sram(sram){ _address=address; _size=size; Clear(); }
+    template<class T> bool Append(const T *data, uint32_t big);
+    template<class T> uint32_t Read(uint32_t first, T *data, uint32_t big);
+    template<class T> uint32_t WriteArray(uint32_t address, const T *data, uint32_t big);
+    template<class T> uint32_t ReadArray(uint32_t address, T *data, uint32_t big);
+    template<class T> static uint32_t Bytes(const T *data, uint32_t big){ Discard none; return Encode(data, big, none); }
+    static uint32_t MaxBytes(uint32_t big){ return (big==0) ? 0 : 5+(big+6)/8*33; }
+    uint32_t Samples(){ return _samples; }
+    byte Blocks(){ return _blocks; }
+    uint32_t Used(){ return _used; }
+    uint32_t Free(){ return _size-_used; }
+    void Clear(){ _blocks=0; _used=0; _samples=0; }
+  private:
+    struct Discard {        // drops the bytes (Encode still counts them)
+      void operator()(byte){}
+    };
+    struct Sender {         // sends them to the chip
+      Memory &sram;
+      void operator()(byte data){ sram.Send(data); }
+    };
+    static uint32_t Zigzag(uint32_t d){ return (d<<1)^((uint32_t)0-(d>>31)); }
+    static uint32_t Unzigzag(uint32_t z){ return (z>>1)^((uint32_t)0-(z&1)); }
+    template<class T, class Out> static uint32_t Encode(const T *data, uint32_t big, Out &out);
+    template<class T> uint32_t Decode(T *data, uint32_t big, uint32_t skip);
+    struct Block {
+      uint32_t offset;      // bytes from _address
+      uint32_t first;       // number of its first sample
+    };
+    Memory &_sram;
+    uint32_t _address;      // chip address of the log
+    uint32_t _size;         // bytes the log may use
+    uint32_t _used;         // bytes it uses
+    uint32_t _samples;      // samples in it
+    Block _index[BLOCKS];
+    byte _blocks;           // blocks in it
+};
+
+/*  Pack big values into out: the first one as a zig-zag varint (7 bits per byte, low bits first),
+ *  then groups of 8 differences: a width byte w, and w bytes holding 8 values of w bits, low bits
+ *  first. The last group is padded with zeros. Returns the bytes sent to out */
+template<byte BLOCKS, class Memory> template<class T, class Out>
+uint32_t SRAMpack<BLOCKS, Memory>::Encode(const T *data, uint32_t big, Out &out){
+  static_assert(sizeof(T)<=4, "SRAMpack packs integers of up to 32 bits");
+  if(big==0) return 0;
+  uint32_t bytes=1;
+  uint32_t prev=(uint32_t)data[0];
+  uint32_t v=Zigzag(prev);
+  for(; v>=0x80; v>>=7, bytes++) out((byte)(v|0x80));
+  out((byte)v);
+  uint32_t z[8];                                  // one group
+  for(uint32_t i=1; i<big; i+=8){
+    uint32_t all=0;
+    for(byte j=0; j<8; j++){
+      z[j]=0;
+      if(i+j<big){
+        uint32_t value=(uint32_t)data[i+j];
+        z[j]=Zigzag(value-prev);                  // wraps like the integers do, so any difference fits
+        prev=value;
+      }
+      all|=z[j];
+    }
+    byte w=0;                                     // bits needed for the biggest one
+    for(; all; all>>=1) w++;
+    out(w);
+    bytes+=1+w;
+    byte acc=0, used=0;                           // bits waiting to go out
+    for(byte j=0; j<8; j++){
+      uint32_t bits=z[j];
+      for(byte left=w; left>0;){
+        byte take=(8-used<left) ? 8-used : left;
+        acc|=(byte)((bits&((1UL<<take)-1))<<used);
+        bits>>=take;
+        used+=take;
+        left-=take;
+        if(used==8){
+          out(acc);
+          acc=0;
+          used=0;
+        }
+      }
+    }
+  }
+  return bytes;
+}
+
+/*  Unpack skip+big values from the open read, keeping the last big. Returns the bytes read */
+template<byte BLOCKS, class Memory> template<class T>
+uint32_t SRAMpack<BLOCKS, Memory>::Decode(T *data, uint32_t big, uint32_t skip){
+  static_assert(sizeof(T)<=4, "SRAMpack packs integers of up to 32 bits");
+  uint32_t total=skip+big;
+  if(total==0) return 0;
+  uint32_t bytes=0;
+  uint32_t v=0;
+  byte in;
+  byte shift=0;
+  do{
+    in=_sram.Receive();
+    bytes++;
+    v|=(uint32_t)(in&0x7F)<<shift;
+    shift+=7;
+  }while(in&0x80);
+  uint32_t prev=Unzigzag(v);
+  if(skip==0) data[0]=(T)prev;
+  for(uint32_t i=1; i<total;){
+    byte w=_sram.Receive();
+    bytes+=1+w;
+    byte acc=0, have=0;                           // bits of the last byte read not used yet
+    for(byte j=0; j<8; j++){
+      uint32_t z=0;
+      for(byte got=0; got<w;){
+        if(have==0){
+          acc=_sram.Receive();
+          have=8;
+        }
+        byte take=(have<w-got) ? have : w-got;
+        z|=(uint32_t)(acc&((1<<take)-1))<<got;
+        acc>>=take;
+        have-=take;
+        got+=take;
+      }
+      if(i<total){                                // the rest of the last group is padding
+        prev+=Unzigzag(z);
+        if(i>=skip) data[i-skip]=(T)prev;
+        i++;
+      }
+    }
+  }
+  return bytes;
+}
+
+/************ One packed array, anywhere on the chip (no index) ***************************/
+
+/*  Returns the bytes it takes on the chip (at most MaxBytes(big)) **********/
+template<byte BLOCKS, class Memory> template<class T>
+uint32_t SRAMpack<BLOCKS, Memory>::WriteArray(uint32_t address, const T *data, uint32_t big){
+  Sender out={_sram};
+  _sram.BeginWrite(address);
+  uint32_t bytes=Encode(data, big, out);
+  _sram.End();
+  return bytes;
+}
+
+/*  big must be the number of values that were written. Returns the bytes read **********/
+template<byte BLOCKS, class Memory> template<class T>
+uint32_t SRAMpack<BLOCKS, Memory>::ReadArray(uint32_t address, T *data, uint32_t big){
+  _sram.BeginRead(address);
+  uint32_t bytes=Decode(data, big, 0);
+  _sram.End();
+  return bytes;
+}
+
+/************ A log of packed blocks, with an index for random access ***************************/
+
+/*  Pack a block onto the end. Returns false if the index or the space is full **********/
+template<byte BLOCKS, class Memory> template<class T>
+bool SRAMpack<BLOCKS, Memory>::Append(const T *data, uint32_t big){
+  if(_blocks>=BLOCKS || big==0) return false;
+  if(Bytes(data, big)>_size-_used) return false;  // size it first, so a block never runs past the end
+  _index[_blocks].offset=_used;
+  _index[_blocks].first=_samples;
+  _blocks++;
+  _used+=WriteArray(_address+_used, data, big);
+  _samples+=big;
+  return true;
+}
+
+/*  Samples first to first+big-1, across blocks, in one sequential read. Returns how many there were */
+template<byte BLOCKS, class Memory> template<class T>
+uint32_t SRAMpack<BLOCKS, Memory>::Read(uint32_t first, T *data, uint32_t big){
+  if(first>=_samples) return 0;
+  if(big>_samples-first) big=_samples-first;
+  byte b=_blocks-1;
+  while(_index[b].first>first) b--;               // block holding the first sample
+  uint32_t skip=first-_index[b].first;            // unpacked and dropped
+  uint32_t done=0;
+  _sram.BeginRead(_address+_index[b].offset);     // blocks follow each other, so one read does
+  while(done<big){
+    uint32_t length=((b+1<_blocks) ? _index[b+1].first : _samples)-_index[b].first;
+    uint32_t n=(length-skip<big-done) ? length-skip : big-done;
+    Decode(data+done, n, skip);
+    done+=n;
+    skip=0;
+    b++;
+  }
+  _sram.End();
+  return big;
+}
+
+#endif
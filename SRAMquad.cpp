@@ -0,0 +1,128 @@
+/*  SRAMquad.cpp - Bit-banged SQI (4 data lines), SDI (2) or SPI (1) bus for a 23LC1024.
+ *  Extends SRAMsimple, by David Dubins.
+ *  Released into the public domain.
+ */
+
+#include "Arduino.h"
+#include "SRAMquad.h"
+
+SRAMquad::SRAMquad(byte SCKpin, byte SIO0, byte SIO1, byte SIO2, byte SIO3, byte width){
+  _sck=SCKpin;
+  _sio[0]=SIO0;                                   // SI in SPI mode
+  _sio[1]=SIO1;                                   // SO in SPI mode
+  _sio[2]=SIO2;
+  _sio[3]=SIO3;                                   // HOLD in SPI and SDI mode
+  if(width>=4 && SIO2!=QuadNoPin && SIO3!=QuadNoPin) _width=4;   // SQI needs all four lines wired
+  else if(width>=2) _width=2;
+  else _width=1;
+  _out=false;
+#if defined(__AVR__)
+  _sckPort=portOutputRegister(digitalPinToPort(_sck));  // look up the ports once, not on every clock
+  _sckMask=digitalPinToBitMask(_sck);
+  _parallel=false;
+  if(_width==4){                                  // SIO0-SIO3 on neighbouring bits of one port?
+    byte port=digitalPinToPort(SIO0);
+    uint8_t mask=digitalPinToBitMask(SIO0);
+    _parallel=(mask<=0x10);
+    for(byte i=1; i<4; i++){
+      if(digitalPinToPort(_sio[i])!=port || digitalPinToBitMask(_sio[i])!=(uint8_t)(mask<<i)) _parallel=false;
+    }
+    if(_parallel){
+      _dataOut=portOutputRegister(port);
+      _dataIn=portInputRegister(port);
+      _dataDdr=portModeRegister(port);
+      _dataShift=0;
+      while(!(mask&1)){ mask>>=1; _dataShift++; }
+    }
+  }
+#endif
+}
+
+/*  SCK idles low (mode 0); SI and unused lines high, so HOLD is never asserted **********/
+void SRAMquad::Attach(){
+  digitalWrite(_sck, LOW);
+  pinMode(_sck, OUTPUT);
+  for(byte i=0; i<4; i++){
+    if(_sio[i]==QuadNoPin || (i==1 && _width==1)) continue;  // SO is the chip's in SPI mode
+    digitalWrite(_sio[i], HIGH);
+    pinMode(_sio[i], OUTPUT);
+  }
+  if(_width==1) pinMode(_sio[1], INPUT);
+  _out=true;
+}
+
+/*  Turn the data lines around: outputs to talk, inputs to listen (SDI/SQI only) **********/
+void SRAMquad::Drive(bool out){
+  if(out==_out || _width==1) return;              // SPI mode: SI always out, SO always in
+  _out=out;
+#if defined(__AVR__)
+  if(_parallel){
+    if(out) *_dataDdr |= (0x0F<<_dataShift);
+    else *_dataDdr &= ~(0x0F<<_dataShift);
+    return;
+  }
+#endif
+  for(byte i=0; i<_width; i++) pinMode(_sio[i], out ? OUTPUT : INPUT);
+}
+
+/*  One clock: the low _width bits on SIO0 and up, latched by the chip on the rising edge **********/
+void SRAMquad::Put(byte bits){
+#if defined(__AVR__)
+  if(_parallel){
+    *_dataOut = (*_dataOut & ~(0x0F<<_dataShift)) | ((bits&0x0F)<<_dataShift);
+    *_sckPort |= _sckMask;
+    *_sckPort &= ~_sckMask;
+    return;
+  }
+#endif
+  for(byte i=0; i<_width; i++) digitalWrite(_sio[i], (bits>>i)&1);
+  digitalWrite(_sck, HIGH);
+  digitalWrite(_sck, LOW);
+}
+
+/*  One clock: the chip's bits are valid while SCK is high **********/
+byte SRAMquad::Get(){
+  byte bits=0;
+#if defined(__AVR__)
+  if(_parallel){
+    *_sckPort |= _sckMask;
+    bits=(*_dataIn>>_dataShift)&0x0F;
+    *_sckPort &= ~_sckMask;
+    return bits;
+  }
+#endif
+  digitalWrite(_sck, HIGH);
+  if(_width==1){
+    bits=digitalRead(_sio[1]);                    // SPI mode: the chip answers on SO
+  }else{
+    for(byte i=0; i<_width; i++) bits|=digitalRead(_sio[i])<<i;
+  }
+  digitalWrite(_sck, LOW);
+  return bits;
+}
+
+/*  RSTIO with every line high: 0xFF whether the chip is in SPI, SDI or SQI mode **********/
+void SRAMquad::Reset(){
+  Drive(true);
+  for(byte i=0; i<8; i++) Put(0x0F);
+}
+
+/*  EDIO or EQIO, one bit per clock on SI, with HOLD (and the other lines) high **********/
+void SRAMquad::Enter(){
+  if(_width==1) return;                           // already there
+  byte command=(_width==4) ? EQIO : EDIO;
+  Drive(true);
+  for(byte i=0; i<8; i++) Put(((command<<i)&0x80) ? 0x0F : 0x0E);
+}
+
+void SRAMquad::Send(byte data){
+  Drive(true);
+  for(int8_t shift=8-_width; shift>=0; shift-=_width) Put(data>>shift);  // high bits first
+}
+
+byte SRAMquad::Receive(){
+  Drive(false);
+  byte data=0;
+  for(byte n=0; n<8; n+=_width) data=(data<<_width)|Get();
+  return data;
+}
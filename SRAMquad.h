@@ -0,0 +1,53 @@
+/*  SRAMquad.h - Bit-banged SQI (4 data lines), SDI (2) or SPI (1) bus for a 23LC1024.
+ *  The 23LC1024 can move 4 bits per clock after an EQIO command, or 2 after EDIO. SRAMquad drives
+ *  SCK and the SIO pins directly, so a quad read takes 2 clocks per byte instead of 8:
+ *    SRAMquad quad(SCKpin, SIO0, SIO1, SIO2, SIO3);   // SIO0=SI (chip pin 5), SIO1=SO (pin 2),
+ *    sram.SetBus(&quad);                              // SIO2 (pin 3), SIO3=HOLD (pin 7)
+ *  width is the most data lines to use (1, 2 or 4). With SIO2 or SIO3 left as QuadNoPin the bus
+ *  can only be 2 wide (SDI), whatever width asks for: GetWidth() tells what it got.
+ *  On AVR, if SIO0-SIO3 are 4 neighbouring bits of one port in order (A0-A3 on an Uno), each
+ *  nibble is written and read with one port access; otherwise each pin goes through
+ *  digitalWrite()/digitalRead(), which works anywhere but is much slower.
+ *  The pins must not be the hardware SPI pins while the SPI library is running.
+ *  Extends SRAMsimple, by David Dubins.
+ *  Released into the public domain.
+ */
+
+#ifndef SRAMquad_h
+#define SRAMquad_h
+
+#include <Arduino.h>
+#include "SRAMsimple.h"
+
+#define QuadNoPin   0xFF    // SIO pin not wired to the board (pulled up)
+
+class SRAMquad : public SRAMbus {
+  public:
+    SRAMquad(byte SCKpin, byte SIO0, byte SIO1, byte SIO2=QuadNoPin, byte SIO3=QuadNoPin, byte width=4);
+    byte GetWidth(){ return _width; }
+    virtual void Attach();
+    virtual void Reset();
+    virtual void Enter();
+    virtual void Send(byte data);
+    virtual byte Receive();
+    virtual byte Dummies(){ return (_width>1) ? 1 : 0; }   // SDI/SQI reads wait one byte
+  private:
+    void Drive(bool out);
+    void Put(byte bits);
+    byte Get();
+    byte _sck;
+    byte _sio[4];
+    byte _width;            // data lines in use: 1 (SPI), 2 (SDI) or 4 (SQI)
+    bool _out;              // SIO pins are outputs (we are talking, not listening)
+#if defined(__AVR__)
+    volatile uint8_t *_sckPort;
+    uint8_t _sckMask;
+    volatile uint8_t *_dataOut;   // SIO0-SIO3 on one port: its output, input and direction registers
+    volatile uint8_t *_dataIn;
+    volatile uint8_t *_dataDdr;
+    uint8_t _dataShift;     // bit of SIO0 in that port
+    bool _parallel;         // true if the fast port path can be used
+#endif
+};
+
+#endif
@@ -0,0 +1,169 @@
+/*  SRAMring.h - FIFO of values on a 23LC1024 (SRAMsimple or SRAMbank), filled from an interrupt.
+ *  Push() is safe to call from an ISR (an ADC or timer interrupt): it never touches SPI, it only
+ *  copies the value into one of two staging blocks of STAGE values in MCU RAM. When a block is
+ *  full, the other one takes over, and the main loop commits the full block to the chip with one
+ *  sequential write (Service(), also called by Pop() and Available()). Pop() reads back in bursts.
+ *  If the main loop falls behind and both blocks are full, or the chip is full, values are
+ *  dropped and counted in Overflows(). HighWater() is the most values ever waiting on the chip,
+ *  to help size the ring.
+ *  One producer (Push) and one consumer (everything else, from the main loop only).
+ *  RAM used: 2*STAGE*sizeof(T) bytes, plus about 30 bytes.
+ *  Extends SRAMsimple, by David Dubins.
+ *  Released into the public domain.
+ */
+
+#ifndef SRAMring_h
+#define SRAMring_h
+
+#include <Arduino.h>
+#include "SRAMsimple.h"
+
+template<class T, byte STAGE=16, class Memory=SRAMsimple>
+class SRAMring {
+  public:
+    SRAMring(Memory &sram, uint32_t address=0, uint32_t capacity=SRAMsize/sizeof(T));
+    bool Push(const T &data);
+    uint32_t Pop(T *data, uint32_t big);
+    bool Pop(T &data){ return Pop(&data, 1)==1; }
+    void Service();
+    void Flush();
+    uint32_t Available();
+    uint32_t Capacity(){ return _capacity; }
+    unsigned long Overflows();
+    uint32_t HighWater(){ return _highWater; }
+    void Clear();
+  private:
+    void Reset();
+    void Commit(byte block);
+    Memory &_sram;
+    uint32_t _address;              // first byte of the ring on the chip
+    uint32_t _capacity;             // values the ring holds
+    uint32_t _head;                 // where the next committed value goes (value number)
+    uint32_t _tail;                 // next value to pop
+    uint32_t _used;                 // values on the chip
+    uint32_t _highWater;            // most values ever on the chip
+    T _stage[2][STAGE];             // staging blocks the ISR fills
+    volatile byte _len[2];          // values in each staging block
+    volatile bool _ready[2];        // block is full (or flushed) and waiting to be committed
+    volatile byte _filling;         // block Push() writes to
+    byte _commit;                   // next block to commit: blocks fill in turn
+    volatile unsigned long _overflows;
+};
+
+template<class T, byte STAGE, class Memory>
+SRAMring<T, STAGE, Memory>::SRAMring(Memory &sram, uint32_t address, uint32_t capacity) : _sram(sram){
+  _address=address;
+  _capacity=capacity;
+  Reset();
+}
+
+/*  Empty the ring and reset the counters (main loop) **********/
+template<class T, byte STAGE, class Memory>
+void SRAMring<T, STAGE, Memory>::Clear(){
+  noInterrupts();
+  Reset();
+  interrupts();
+}
+
+template<class T, byte STAGE, class Memory>
+void SRAMring<T, STAGE, Memory>::Reset(){
+  _head=_tail=_used=0;
+  _highWater=0;
+  _len[0]=_len[1]=0;
+  _ready[0]=_ready[1]=false;
+  _filling=_commit=0;
+  _overflows=0;
+}
+
+/*  Producer: ISR safe, no SPI. Returns false if the value was dropped **********/
+template<class T, byte STAGE, class Memory>
+bool SRAMring<T, STAGE, Memory>::Push(const T &data){
+  byte b=_filling;
+  if(_ready[b]){                                  // both blocks waiting for the main loop
+    _overflows++;
+    return false;
+  }
+  _stage[b][_len[b]]=data;
+  if(++_len[b]==STAGE){                           // block full: hand it over, fill the other one
+    _ready[b]=true;
+    _filling=b^1;
+  }
+  return true;
+}
+
+/*  Write one staging block to the chip: one burst, or two if it wraps around the ring **********/
+template<class T, byte STAGE, class Memory>
+void SRAMring<T, STAGE, Memory>::Commit(byte block){
+  uint32_t n=_len[block];
+  uint32_t room=_capacity-_used;
+  if(n>room){                                     // chip full: the newest values go
+    noInterrupts();
+    _overflows+=n-room;
+    interrupts();
+    n=room;
+  }
+  uint32_t first=_capacity-_head;                 // values before the end of the ring
+  if(first>n) first=n;
+  if(first>0) _sram.WriteArray(_address+_head*sizeof(T), _stage[block], first);
+  if(n>first) _sram.WriteArray(_address, _stage[block]+first, n-first);
+  _head=(_head+n)%_capacity;
+  _used+=n;
+  if(_used>_highWater) _highWater=_used;
+  _len[block]=0;
+  _ready[block]=false;                            // Push() may use the block again
+}
+
+/*  Consumer side: commit every full staging block **********/
+template<class T, byte STAGE, class Memory>
+void SRAMring<T, STAGE, Memory>::Service(){
+  while(_ready[_commit]){
+    Commit(_commit);
+    _commit^=1;
+  }
+}
+
+/*  Commit the partly filled block too, so Pop() can see every value pushed so far **********/
+template<class T, byte STAGE, class Memory>
+void SRAMring<T, STAGE, Memory>::Flush(){
+  Service();                                      // now _commit is the block being filled
+  noInterrupts();
+  byte b=_filling;
+  bool some=(!_ready[b] && _len[b]>0);
+  if(some){
+    _ready[b]=true;
+    _filling=b^1;
+  }
+  interrupts();
+  if(some) Service();
+}
+
+/*  Values on the chip, ready to Pop() **********/
+template<class T, byte STAGE, class Memory>
+uint32_t SRAMring<T, STAGE, Memory>::Available(){
+  Service();
+  return _used;
+}
+
+/*  Up to big values, oldest first, in one or two bursts. Returns how many **********/
+template<class T, byte STAGE, class Memory>
+uint32_t SRAMring<T, STAGE, Memory>::Pop(T *data, uint32_t big){
+  Service();
+  uint32_t n=(big<_used)?big:_used;
+  uint32_t first=_capacity-_tail;                 // values before the end of the ring
+  if(first>n) first=n;
+  if(first>0) _sram.ReadArray(_address+_tail*sizeof(T), data, first);
+  if(n>first) _sram.ReadArray(_address, data+first, n-first);
+  _tail=(_tail+n)%_capacity;
+  _used-=n;
+  return n;
+}
+
+template<class T, byte STAGE, class Memory>
+unsigned long SRAMring<T, STAGE, Memory>::Overflows(){
+  noInterrupts();                                 // 4 bytes: don't let Push() change it halfway
+  unsigned long n=_overflows;
+  interrupts();
+  return n;
+}
+
+#endif
@@ -7,431 +7,326 @@
 #include "Arduino.h"
 #include "SRAMsimple.h"
 
-SRAMsimple::SRAMsimple(){/*nothing to construct*/}
+SRAMsimple::SRAMsimple(byte CSpin) : _settings(SRAMmaxClock, MSBFIRST, SPI_MODE0){
+  _cs=CSpin;                                    // each instance has its own chip select
+#if defined(__AVR__)
+  _csPort=portOutputRegister(digitalPinToPort(_cs));  // look up the port once, not on every toggle
+  _csMask=digitalPinToBitMask(_cs);
+#endif
+  _mode=ModeUnknown;                            // chip mode unknown until we write it
+  _seqOnly=false;
+  _bus=0;                                       // hardware SPI
+#if defined(SRAMSIMPLE_STATS)
+  _kind=StatStream;                             // bytes sent outside any call (shouldn't happen)
+  _timing=false;
+  ResetStats();
+#endif
+}
 SRAMsimple::~SRAMsimple(){/*nothing to destruct*/}
 
-byte CS=10; // default CS global variable
-
-/*  Set up the memory chip to either single byte or sequence of bytes mode **********/
-void SRAMsimple::SetMode(byte CSpin, char Mode){            // Select for single or multiple byte transfer
-  CS=CSpin; // set global variable CS to user-defined CS pin
-  pinMode(CS, OUTPUT);	                        // set CS pin to output mode
-  digitalWrite(CS, LOW);                        // set SPI slave select LOW
-  SPI.transfer(WRMR);                           // command to write to mode register
-  SPI.transfer(Mode);                           // set for sequential mode
-  digitalWrite(CS, HIGH);                       // release chip select to finish command
+byte SRAMsimple::GetCS(){
+  return _cs;
 }
 
-/************ Byte transfer functions ***************************/
-void SRAMsimple::WriteByte(uint32_t address, byte data_byte) {
-  SetMode(CS,ByteMode);                 // set to send/receive single byte of data
-  digitalWrite(CS, LOW);                         // set SPI slave select LOW;
-  SPI.transfer(WRITE);                           // send WRITE command to the memory chip
-  SPI.transfer((byte)(address >> 16));           // send high byte of address
-  SPI.transfer((byte)(address >> 8));            // send middle byte of address
-  SPI.transfer((byte)address);                   // send low byte of address
-  SPI.transfer(data_byte);                       // write the data to the memory location
-  digitalWrite(CS, HIGH);                        //set SPI slave select HIGH
+/*  SPI settings for this chip. Default: 20 MHz (or the fastest the board can do), MSB first, mode 0 */
+void SRAMsimple::SetSPISettings(SPISettings settings){
+  _settings=settings;
 }
 
-byte SRAMsimple::ReadByte(uint32_t address) {
-  SetMode(CS,ByteMode);                 // set to send/receive single byte of data
-  char read_byte;
-  digitalWrite(CS, LOW);                         // set SPI slave select LOW;
-  SPI.transfer(READ);                            // send READ command to memory chip
-  SPI.transfer((byte)(address >> 16));           // send high byte of address
-  SPI.transfer((byte)(address >> 8));            // send middle byte of address
-  SPI.transfer((byte)address);                   // send low byte of address
-  read_byte = SPI.transfer(0x00);                // read the byte at that address
-  digitalWrite(CS, HIGH);                        // set SPI slave select HIGH;
-  return read_byte;                              // send data back to the calling function
+void SRAMsimple::SetClock(uint32_t clock){
+  _settings=SPISettings(clock, MSBFIRST, SPI_MODE0);
 }
 
-/*********** Sequential data transfer functions using Arrays ************************/
-void SRAMsimple::WriteByteArray(uint32_t address, byte *data, uint16_t big){
-  SetMode(CS,Sequential);                // set to send/receive multiple bytes of data
-  digitalWrite(CS, LOW);                          // start new command sequence
-  SPI.transfer(WRITE);                            // send WRITE command
-  SPI.transfer((byte)(address >> 16));            // send high byte of address
-  SPI.transfer((byte)(address >> 8));             // send middle byte of address
-  SPI.transfer((byte)address);                    // send low byte of address
-  SPI.transfer(data, big);                        // transfer an array of data => needs array name & size
-  digitalWrite(CS, HIGH);                         // set SPI slave select HIGH
+/*  Talk to the chip over another bus (e.g. an SRAMquad), or over hardware SPI again (0).
+ *  RSTIO puts the chip back in SPI mode first, then the new bus sends EDIO/EQIO if it needs to */
+void SRAMsimple::SetBus(SRAMbus *bus){
+  SRAM_STAT_CALL(StatControl);
+  digitalWrite(_cs, HIGH);                      // make sure CS doesn't glitch low when it becomes an output
+  pinMode(_cs, OUTPUT);
+  if(_bus){
+    Select();
+    _bus->Reset();                              // leave SDI/SQI mode through the old bus
+    Deselect();
+    SRAM_STAT_ADD(commands, 1);
+    SRAM_STAT_ADD(overhead, 1);
+  }
+  _bus=bus;
+  if(_bus){
+    _bus->Attach();
+    Select();
+    _bus->Reset();                              // in case the chip was left in SDI/SQI mode
+    Deselect();
+    Select();
+    _bus->Enter();
+    Deselect();
+    SRAM_STAT_ADD(commands, 2);                 // RSTIO and EDIO/EQIO
+    SRAM_STAT_ADD(overhead, 2);
+  }
 }
 
-void SRAMsimple::ReadByteArray(uint32_t address, byte *data, uint16_t big){
-  SetMode(CS,Sequential);                         // set to send/receive multiple bytes of data
-  digitalWrite(CS, LOW);                          // start new command sequence
-  SPI.transfer(READ);                             // send READ command
-  SPI.transfer((byte)(address >> 16));            // send high byte of address
-  SPI.transfer((byte)(address >> 8));             // send middle byte of address
-  SPI.transfer((byte)address);                    // send low byte of address
-  for(uint16_t i=0; i<big; i++){
-    data[i] = SPI.transfer(0x00);                 // read the data byte
-  }
-  digitalWrite(CS, HIGH);                         // set SPI slave select HIGH
+/*  Take the SPI bus with this chip's settings, and pull CS low **********/
+inline void SRAMsimple::Select(){
+  if(!_bus) SPI.beginTransaction(_settings);    // clock speed and mode for this chip
+  CSLow();                                      // set SPI slave select LOW
+  SRAM_STAT_ADD(selects, 1);
 }
 
-/*********** Write and Read an Integer (2 bytes) ************************/
-void SRAMsimple::WriteInt(uint32_t address, int data){
-  SetMode(CS,Sequential);                         // set to send/receive multiple bytes of data
-  byte temp[2]; 				  // temporary array of bytes with 2 elements
-  temp[0]=(byte)(data>>8);                        // high byte of integer
-  temp[1]=(byte)(data);                           // low byte of integer
-  digitalWrite(CS, LOW);                          // start new command sequence
-  SPI.transfer(WRITE);                            // send WRITE command
-  SPI.transfer((byte)(address >> 16));            // send high byte of address
-  SPI.transfer((byte)(address >> 8));             // send middle byte of address
-  SPI.transfer((byte)address);                    // send low byte of address
-  SPI.transfer(temp, 2);                          // transfer an array of data => needs array name & size (2 elements)
-  digitalWrite(CS, HIGH);                         // set SPI slave select HIGH
+/*  Release CS, and give the SPI bus back to other devices **********/
+inline void SRAMsimple::Deselect(){
+  CSHigh();                                     // set SPI slave select HIGH
+  if(!_bus) SPI.endTransaction();
 }
 
-int SRAMsimple::ReadInt(uint32_t address){
-  SetMode(CS,Sequential);                         // set to send/receive multiple bytes of data
-  byte temp[2]; 				  // temporary array of bytes with 2 elements
-  int data=0;
-  digitalWrite(CS, LOW);                          // start new command sequence
-  SPI.transfer(READ);                             // send READ command
-  SPI.transfer((byte)(address >> 16));            // send high byte of address
-  SPI.transfer((byte)(address >> 8));             // send middle byte of address
-  SPI.transfer((byte)address);                    // send low byte of address
-  for(uint16_t i=0; i<2; i++){
-    temp[i] = SPI.transfer(0x00);                 // read the data byte
+/*  Set up the memory chip to either single byte or sequence of bytes mode **********/
+void SRAMsimple::SetMode(byte CSpin, char Mode){            // Select for single or multiple byte transfer
+  SRAM_STAT_CALL(StatControl);                  // (inside another call, charged to that call)
+  if(CSpin!=_cs){
+    _cs=CSpin;                                  // set CS pin for this chip
+#if defined(__AVR__)
+    _csPort=portOutputRegister(digitalPinToPort(_cs));
+    _csMask=digitalPinToBitMask(_cs);
+#endif
   }
-  digitalWrite(CS, HIGH);                         // set SPI slave select HIGH
-  data=((int)temp[0]<<8)+temp[1];                      // data=high byte & low byte
-  return data;
+  digitalWrite(_cs, HIGH);                      // make sure CS doesn't glitch low when it becomes an output
+  pinMode(_cs, OUTPUT);	                        // set CS pin to output mode
+  Select();                                     // set SPI slave select LOW
+  Out(WRMR);                                    // command to write to mode register
+  Out(Mode);                                    // set for sequential mode
+  Deselect();                                   // release chip select to finish command
+  SRAM_STAT_ADD(commands, 1);
+  SRAM_STAT_ADD(overhead, 2);
+  _mode=(byte)Mode;                             // remember what the chip is set to
 }
 
-/*********** Write and Read an Integer Array ************************/
-void SRAMsimple::WriteIntArray(uint32_t address, int *data, uint16_t big){
-  SetMode(CS,Sequential);                         // set to send/receive multiple bytes of data
-  byte temp[big*2]; 				  // temporary array of bytes with 2 elements
-  uint16_t j=0;                                   // byte counter
-  for(uint16_t i=0; i<big; i++){                   // take apart integers into high and low bytes
-    temp[j]=(byte)(data[i]>>8);                   // high byte of integer
-    temp[j+1]=(byte)(data[i]);                    // low byte of integer
-    j+=2;                                         // increment counter
-  }
-  digitalWrite(CS, LOW);                          // start new command sequence
-  SPI.transfer(WRITE);                            // send WRITE command
-  SPI.transfer((byte)(address >> 16));            // send high byte of address
-  SPI.transfer((byte)(address >> 8));             // send middle byte of address
-  SPI.transfer((byte)address);                    // send low byte of address
-  SPI.transfer(temp, big*2);                      // transfer an array of data => needs array name & size (2 elements)
-  digitalWrite(CS, HIGH);                         // set SPI slave select HIGH
+/*  Read back the mode register, and refresh the cached copy with what the chip reports */
+char SRAMsimple::ReadMode(){
+  SRAM_STAT_CALL(StatControl);
+  digitalWrite(_cs, HIGH);                      // make sure CS doesn't glitch low when it becomes an output
+  pinMode(_cs, OUTPUT);                         // set CS pin to output mode
+  Select();                                     // set SPI slave select LOW
+  Out(RDMR);                                    // command to read the mode register
+  char Mode = In();                             // read the mode register
+  Deselect();                                   // release chip select to finish command
+  SRAM_STAT_ADD(commands, 1);
+  SRAM_STAT_ADD(overhead, 2);
+  _mode=(byte)Mode;                             // chip is now in a known mode
+  return Mode;
 }
 
-void SRAMsimple::ReadIntArray(uint32_t address, int *data, uint16_t big){
-  SetMode(CS,Sequential);                         // set to send/receive multiple bytes of data
-  byte temp[big*2]; 				  // temporary array of bytes with 2 elements
-  uint16_t j=0;                                   // byte counter
-  digitalWrite(CS, LOW);                          // start new command sequence
-  SPI.transfer(READ);                             // send READ command
-  SPI.transfer((byte)(address >> 16));            // send high byte of address
-  SPI.transfer((byte)(address >> 8));             // send middle byte of address
-  SPI.transfer((byte)address);                    // send low byte of address
-  for(uint16_t i=0; i<(big*2); i++){
-    temp[i] = SPI.transfer(0x00);                 // read the data byte
-  }
-  digitalWrite(CS, HIGH);                         // set SPI slave select HIGH
-  for(uint16_t i=0; i<big; i++){
-    data[i]=((int)temp[j]<<8)+temp[j+1];          // data=high byte & low byte
-    j+=2;                                         // increment counter
-  }
+/*  Forget the cached mode, so the next access re-sends WRMR (use after RSTIO or a power glitch) */
+void SRAMsimple::ResyncMode(){
+  _mode=ModeUnknown;
 }
 
-/*********** Write and Read an Unsigned Integer (2 bytes) ************************/
-void SRAMsimple::WriteUnsignedInt(uint32_t address, unsigned int data){ 
-  SetMode(CS,Sequential);                         // set to send/receive multiple bytes of data
-  byte temp[2]; 				  // temporary array of bytes with 2 elements
-  temp[0]=(byte)(data>>8);                        // high byte of integer
-  temp[1]=(byte)(data);                           // low byte of integer
-  digitalWrite(CS, LOW);                          // start new command sequence
-  SPI.transfer(WRITE);                            // send WRITE command
-  SPI.transfer((byte)(address >> 16));            // send high byte of address
-  SPI.transfer((byte)(address >> 8));             // send middle byte of address
-  SPI.transfer((byte)address);                    // send low byte of address
-  SPI.transfer(temp, 2);                          // transfer an array of data => needs array name & size (2 elements)
-  digitalWrite(CS, HIGH);                         // set SPI slave select HIGH
+/*  Keep the chip in Sequential mode for everything (single bytes work fine in Sequential) */
+void SRAMsimple::SetSequentialOnly(bool enable){
+  _seqOnly=enable;
 }
 
-unsigned int SRAMsimple::ReadUnsignedInt(uint32_t address){
-  SetMode(CS,Sequential);                         // set to send/receive multiple bytes of data
-  byte temp[2]; 				  // temporary array of bytes with 2 elements
-  unsigned int data=0;
-  digitalWrite(CS, LOW);                          // start new command sequence
-  SPI.transfer(READ);                             // send READ command
-  SPI.transfer((byte)(address >> 16));            // send high byte of address
-  SPI.transfer((byte)(address >> 8));             // send middle byte of address
-  SPI.transfer((byte)address);                    // send low byte of address
-  for(uint16_t i=0; i<2; i++){
-    temp[i] = SPI.transfer(0x00);                 // read the data byte
-  }
-  digitalWrite(CS, HIGH);                         // set SPI slave select HIGH
-  data=(temp[0]<<8)+temp[1];                      // data=high byte & low byte
-  return data;
+/*  Only send WRMR when the chip isn't already in the requested mode **********/
+void SRAMsimple::UseMode(char Mode){
+  if(_seqOnly) Mode=Sequential;                 // single byte transfers work in Sequential too
+  if(_mode!=(byte)Mode) SetMode(_cs,Mode);      // skip the extra CS toggle + 2 byte command
 }
 
-/*********** Write and Read an Unsigned Integer Array ************************/
-void SRAMsimple::WriteUnsignedIntArray(uint32_t address, unsigned int *data, uint16_t big){
-  SetMode(CS,Sequential);                         // set to send/receive multiple bytes of data
-  byte temp[big*2]; 				  // temporary array of bytes with 2 elements
-  uint16_t j=0;                                   // byte counter
-  for(uint16_t i=0; i<big; i++){                   // take apart integers into high and low bytes
-    temp[j]=(byte)(data[i]>>8);                   // high byte of integer
-    temp[j+1]=(byte)(data[i]);                    // low byte of integer
-    j+=2;                                         // increment counter
+/*  Send a command and the 24-bit address, with CS already low **********/
+void SRAMsimple::Command(byte command, uint32_t address){
+  Out(command);                                   // send READ or WRITE command
+  Out((byte)(address >> 16));                     // send high byte of address
+  Out((byte)(address >> 8));                      // send middle byte of address
+  Out((byte)address);                             // send low byte of address
+  SRAM_STAT_ADD(commands, 1);
+  SRAM_STAT_ADD(overhead, 4);
+  if(_bus && command==READ){
+    for(byte i=_bus->Dummies(); i>0; i--){
+      _bus->Receive();                            // SDI/SQI: dummy byte before the data
+      SRAM_STAT_ADD(overhead, 1);
+    }
   }
-  digitalWrite(CS, LOW);                          // start new command sequence
-  SPI.transfer(WRITE);                            // send WRITE command
-  SPI.transfer((byte)(address >> 16));            // send high byte of address
-  SPI.transfer((byte)(address >> 8));             // send middle byte of address
-  SPI.transfer((byte)address);                    // send low byte of address
-  SPI.transfer(temp, big*2);                      // transfer an array of data => needs array name & size (2 elements)
-  digitalWrite(CS, HIGH);                         // set SPI slave select HIGH
 }
 
-void SRAMsimple::ReadUnsignedIntArray(uint32_t address, unsigned int *data, uint16_t big){
-  SetMode(CS,Sequential);                         // set to send/receive multiple bytes of data
-  byte temp[big*2]; 				  // temporary array of bytes with 2 elements
-  uint16_t j=0;                                   // byte counter
-  digitalWrite(CS, LOW);                          // start new command sequence
-  SPI.transfer(READ);                             // send READ command
-  SPI.transfer((byte)(address >> 16));            // send high byte of address
-  SPI.transfer((byte)(address >> 8));             // send middle byte of address
-  SPI.transfer((byte)address);                    // send low byte of address
-  for(uint16_t i=0; i<(big*2); i++){
-    temp[i] = SPI.transfer(0x00);                 // read the data byte
-  }
-  digitalWrite(CS, HIGH);                         // set SPI slave select HIGH
-  for(uint16_t i=0; i<big; i++){
-    data[i]=((int)temp[j]<<8)+temp[j+1];          // data=high byte & low byte
-    j+=2;                                         // increment counter
-  }
+/************ Sequential transactions: Begin, then Send/Receive any number of bytes, then End **/
+void SRAMsimple::BeginWrite(uint32_t address){
+#if defined(SRAMSIMPLE_STATS)
+  StatStart(StatStream);                          // timed until End(), unless a call inside the library began it
+#endif
+  UseMode(Sequential);                            // set to send/receive multiple bytes of data
+  Select();                                       // start new command sequence
+  Command(WRITE, address);
 }
 
-/*********** Write and Read a Long (4 bytes) ************************/
-void SRAMsimple::WriteLong(uint32_t address, long data){  
-  SetMode(CS,Sequential);                         // set to send/receive multiple bytes of data
-  byte temp[4]; 				  // temporary array of bytes with 4 elements
-  temp[0]=(byte)(data >> 24);                     // high byte of integer
-  temp[1]=(byte)(data >> 16);                     // low byte of integer
-  temp[2]=(byte)(data >> 8);                      // low byte of integer
-  temp[3]=(byte)(data);                           // low byte of integer
-  digitalWrite(CS, LOW);                          // start new command sequence
-  SPI.transfer(WRITE);                            // send WRITE command
-  SPI.transfer((byte)(address >> 16));            // send high byte of address
-  SPI.transfer((byte)(address >> 8));             // send middle byte of address
-  SPI.transfer((byte)address);                    // send low byte of address
-  SPI.transfer(temp, 4);                          // transfer an array of data => needs array name & size (4 elements)
-  digitalWrite(CS, HIGH);                         // set SPI slave select HIGH
+void SRAMsimple::BeginRead(uint32_t address){
+#if defined(SRAMSIMPLE_STATS)
+  StatStart(StatStream);
+#endif
+  UseMode(Sequential);                            // set to send/receive multiple bytes of data
+  Select();                                       // start new command sequence
+  Command(READ, address);
 }
 
-long SRAMsimple::ReadLong(uint32_t address){
-  SetMode(CS,Sequential);                         // set to send/receive multiple bytes of data
-  byte temp[4]; 				  // temporary array of bytes with 4 elements
-  long data=0;
-  digitalWrite(CS, LOW);                          // start new command sequence
-  SPI.transfer(READ);                             // send READ command
-  SPI.transfer((byte)(address >> 16));            // send high byte of address
-  SPI.transfer((byte)(address >> 8));             // send middle byte of address
-  SPI.transfer((byte)address);                    // send low byte of address
-  for(uint16_t i=0; i<4; i++){
-    temp[i] = SPI.transfer(0x00);                 // read the data byte
-  }
-  digitalWrite(CS, HIGH);                         // set SPI slave select HIGH
-  data=((long)temp[0]<<24)+((long)temp[1]<<16)+((long)temp[2]<<8)+temp[3];   // reassemble bytes into long
-  return data;
+void SRAMsimple::End(){
+  Deselect();                                     // set SPI slave select HIGH
+#if defined(SRAMSIMPLE_STATS)
+  if(_timing && _kind==StatStream) StatStop();
+#endif
 }
 
-/*********** Write and Read a Long Array ************************/
-void SRAMsimple::WriteLongArray(uint32_t address, long *data, uint16_t big){
-  SetMode(CS,Sequential);                         // set to send/receive multiple bytes of data
-  byte temp[big*4]; 				  // temporary array of bytes with 2 elements
-  uint16_t j=0;                                   // byte counter
-  for(uint16_t i=0; i<big; i++){                  // take apart integers into high and low bytes
-    temp[j]=(byte)(data[i] >> 24);                // high byte of integer
-    temp[j+1]=(byte)(data[i] >> 16);              // low byte of integer
-    temp[j+2]=(byte)(data[i] >> 8);               // low byte of integer
-    temp[j+3]=(byte)data[i];                      // low byte of integer
-    j+=4;                                         // increment counter
+/************ Stream a block (default: the whole chip) out to Serial, or any Print, and back in
+ *  One sequential transfer, whatever the length. Past 0x1FFFF the chip wraps around to 0. */
+void SRAMsimple::Dump(Print &out, uint32_t address, uint32_t big){
+  SRAM_STAT_CALL(StatBulk);
+  byte temp[32];                                  // a page at a time, so Print can send it in one go
+  BeginRead(address);
+  while(big>0){
+    byte n=(big<sizeof(temp))?big:sizeof(temp);
+    for(byte i=0; i<n; i++) temp[i]=Receive();
+    out.write(temp, n);
+    big-=n;
   }
-  digitalWrite(CS, LOW);                          // start new command sequence
-  SPI.transfer(WRITE);                            // send WRITE command
-  SPI.transfer((byte)(address >> 16));            // send high byte of address
-  SPI.transfer((byte)(address >> 8));             // send middle byte of address
-  SPI.transfer((byte)address);                    // send low byte of address
-  SPI.transfer(temp, big*4);                      // transfer an array of data => needs array name & size (2 elements)
-  digitalWrite(CS, HIGH);                         // set SPI slave select HIGH
+  End();
 }
 
-void SRAMsimple::ReadLongArray(uint32_t address, long *data, uint16_t big){
-  SetMode(CS,Sequential);                         // set to send/receive multiple bytes of data
-  byte temp[big*4]; 				  // temporary array of bytes with 2 elements
-  uint16_t j=0;                                   // byte counter
-  digitalWrite(CS, LOW);                          // start new command sequence
-  SPI.transfer(READ);                             // send READ command
-  SPI.transfer((byte)(address >> 16));            // send high byte of address
-  SPI.transfer((byte)(address >> 8));             // send middle byte of address
-  SPI.transfer((byte)address);                    // send low byte of address
-  for(uint16_t i=0; i<(big*4); i++){
-    temp[i] = SPI.transfer(0x00);                 // read the data byte
-  }
-  digitalWrite(CS, HIGH);                         // set SPI slave select HIGH
-  for(uint16_t i=0; i<big; i++){
-    data[i]=((long)temp[j]<<24)+((long)temp[j+1]<<16)+((long)temp[j+2]<<8)+temp[j+3];  // put together 4 bytes
-    j+=4;                                         // increment counter
+/*  Returns the number of bytes written: less than big if the Stream timed out **********/
+uint32_t SRAMsimple::Restore(Stream &in, uint32_t address, uint32_t big){
+  SRAM_STAT_CALL(StatBulk);
+  byte temp[32];                                  // a page at a time
+  uint32_t done=0;
+  BeginWrite(address);
+  while(done<big){
+    byte n=(big-done<sizeof(temp))?(big-done):sizeof(temp);
+    byte got=in.readBytes(temp, n);               // waits up to the Stream timeout
+    for(byte i=0; i<got; i++) Send(temp[i]);
+    done+=got;
+    if(got<n) break;                              // nothing more coming
   }
+  End();
+  return done;
 }
 
-/*********** Write and Read an Unsigned Long (4 bytes) ************************/
-void SRAMsimple::WriteUnsignedLong(uint32_t address, unsigned long data){
-  SetMode(CS,Sequential);                         // set to send/receive multiple bytes of data
-  byte temp[4]; 			 	  // temporary array of bytes with 4 elements
-  temp[0]=(byte)(data >> 24);                     // high byte of integer
-  temp[1]=(byte)(data >> 16);                     // low byte of integer
-  temp[2]=(byte)(data >> 8);                      // low byte of integer
-  temp[3]=(byte)(data);                           // low byte of integer
-  digitalWrite(CS, LOW);                          // start new command sequence
-  SPI.transfer(WRITE);                            // send WRITE command
-  SPI.transfer((byte)(address >> 16));            // send high byte of address
-  SPI.transfer((byte)(address >> 8));             // send middle byte of address
-  SPI.transfer((byte)address);                    // send low byte of address
-  SPI.transfer(temp, 4);                          // transfer an array of data => needs array name & size (4 elements)
-  digitalWrite(CS, HIGH);                         // set SPI slave select HIGH
+/************ Bulk operations: whole blocks, at the full speed of the bus ***************************/
+
+/*  Set big bytes to value, in one sequential write (Fill(0, 0, SRAMsize) clears the chip) */
+void SRAMsimple::Fill(uint32_t address, byte value, uint32_t big){
+  SRAM_STAT_CALL(StatBulk);
+  BeginWrite(address);
+  for(uint32_t i=0; i<big; i++) Send(value);
+  End();
 }
 
-unsigned long SRAMsimple::ReadUnsignedLong(uint32_t address){
-  SetMode(CS,Sequential);                         // set to send/receive multiple bytes of data
-  byte temp[4]; 				  // temporary array of bytes with 4 elements
-  unsigned long data=0;
-  digitalWrite(CS, LOW);                          // start new command sequence
-  SPI.transfer(READ);                             // send READ command
-  SPI.transfer((byte)(address >> 16));            // send high byte of address
-  SPI.transfer((byte)(address >> 8));             // send middle byte of address
-  SPI.transfer((byte)address);                    // send low byte of address
-  for(uint16_t i=0; i<4; i++){
-    temp[i] = SPI.transfer(0x00);                 // read the data byte
+/*  Copy big bytes from one place on the chip to another, a page at a time. The blocks may
+ *  overlap: like memmove, the copy runs from the end when the destination is inside the source */
+void SRAMsimple::Copy(uint32_t from, uint32_t to, uint32_t big){
+  SRAM_STAT_CALL(StatBulk);
+  byte temp[SRAMpage];                            // the chip can't copy by itself: each page passes through here
+  uint32_t ahead=(to-from)&(SRAMsize-1);          // how far the destination is past the source, around the chip
+  if(ahead==0) return;                            // same place: nothing to do
+  bool back=(ahead<big);
+  uint32_t done=0;
+  while(done<big){
+    byte n=(big-done<sizeof(temp))?(big-done):sizeof(temp);
+    uint32_t offset=back ? big-done-n : done;
+    BeginRead((from+offset)&(SRAMsize-1));
+    for(byte i=0; i<n; i++) temp[i]=Receive();
+    End();
+    BeginWrite((to+offset)&(SRAMsize-1));
+    for(byte i=0; i<n; i++) Send(temp[i]);
+    End();
+    done+=n;
   }
-  digitalWrite(CS, HIGH);                         // set SPI slave select HIGH
-  data=((long)temp[0]<<24)+((long)temp[1]<<16)+((long)temp[2]<<8)+temp[3];   // reassemble bytes into long
-  return data;
 }
 
-/*********** Write and Read a Long Array ************************/
-void SRAMsimple::WriteUnsignedLongArray(uint32_t address, unsigned long *data, uint16_t big){
-  SetMode(CS,Sequential);                         // set to send/receive multiple bytes of data
-  byte temp[big*4]; 				  // temporary array of bytes with 2 elements
-  uint16_t j=0;                                   // byte counter
-  for(uint16_t i=0; i<big; i++){                  // take apart integers into high and low bytes
-    temp[j]=(byte)(data[i] >> 24);                // high byte of integer
-    temp[j+1]=(byte)(data[i] >> 16);              // low byte of integer
-    temp[j+2]=(byte)(data[i] >> 8);               // low byte of integer
-    temp[j+3]=(byte)data[i];                      // low byte of integer
-    j+=4;                                         // increment counter
+/*  True if the chip holds the same big bytes as data. Stops reading at the first difference */
+bool SRAMsimple::Compare(uint32_t address, const byte *data, uint32_t big){
+  SRAM_STAT_CALL(StatBulk);
+  bool same=true;
+  BeginRead(address);
+  for(uint32_t i=0; i<big; i++){
+    if(Receive()!=data[i]){
+      same=false;
+      break;
+    }
   }
-  digitalWrite(CS, LOW);                          // start new command sequence
-  SPI.transfer(WRITE);                            // send WRITE command
-  SPI.transfer((byte)(address >> 16));            // send high byte of address
-  SPI.transfer((byte)(address >> 8));             // send middle byte of address
-  SPI.transfer((byte)address);                    // send low byte of address
-  SPI.transfer(temp, big*4);                      // transfer an array of data => needs array name & size (2 elements)
-  digitalWrite(CS, HIGH);                         // set SPI slave select HIGH
+  End();
+  return same;
 }
 
-void SRAMsimple::ReadUnsignedLongArray(uint32_t address, unsigned long *data, uint16_t big){
-  SetMode(CS,Sequential);                         // set to send/receive multiple bytes of data
-  byte temp[big*4]; 				  // temporary array of bytes with 2 elements
-  uint16_t j=0;                                   // byte counter
-  digitalWrite(CS, LOW);                          // start new command sequence
-  SPI.transfer(READ);                             // send READ command
-  SPI.transfer((byte)(address >> 16));            // send high byte of address
-  SPI.transfer((byte)(address >> 8));             // send middle byte of address
-  SPI.transfer((byte)address);                    // send low byte of address
-  for(uint16_t i=0; i<(big*4); i++){
-    temp[i] = SPI.transfer(0x00);                 // read the data byte
-  }
-  digitalWrite(CS, HIGH);                         // set SPI slave select HIGH
-  for(uint16_t i=0; i<big; i++){
-    data[i]=((long)temp[j]<<24)+((long)temp[j+1]<<16)+((long)temp[j+2]<<8)+temp[j+3];  // put together 4 bytes
-    j+=4;                                         // increment counter
-  }
+/************ Byte transfer functions ***************************/
+void SRAMsimple::WriteByte(uint32_t address, byte data_byte) {
+  SRAM_STAT_CALL(StatByte);
+  UseMode(ByteMode);                              // set to send/receive single byte of data
+  Select();                                       // set SPI slave select LOW;
+  Command(WRITE, address);                        // send WRITE command and address to the memory chip
+  Send(data_byte);                                // write the data to the memory location
+  Deselect();                                     // set SPI slave select HIGH
 }
 
-/*********** Write and Read a Float (4 bytes) ************************/
-void SRAMsimple::WriteFloat(uint32_t address, float data){
-  SetMode(CS,Sequential);                         // set to send/receive multiple bytes of data
-  byte *temp=(byte *)&data;                       // split float into 4 bytes
-  digitalWrite(CS, LOW);                          // start new command sequence
-  SPI.transfer(WRITE);                            // send WRITE command
-  SPI.transfer((byte)(address >> 16));            // send high byte of address
-  SPI.transfer((byte)(address >> 8));             // send middle byte of address
-  SPI.transfer((byte)address);                    // send low byte of address
-  SPI.transfer(temp, 4);                          // transfer an array of data => needs array name & size (4 elements)
-  digitalWrite(CS, HIGH);                         // set SPI slave select HIGH
+byte SRAMsimple::ReadByte(uint32_t address) {
+  SRAM_STAT_CALL(StatByte);
+  UseMode(ByteMode);                              // set to send/receive single byte of data
+  byte read_byte;
+  Select();                                       // set SPI slave select LOW;
+  Command(READ, address);                         // send READ command and address to memory chip
+  read_byte = Receive();                          // read the byte at that address
+  Deselect();                                     // set SPI slave select HIGH;
+  return read_byte;                               // send data back to the calling function
 }
 
-float SRAMsimple::ReadFloat(uint32_t address){
-  SetMode(CS,Sequential);                         // set to send/receive multiple bytes of data
-  byte temp[4]; 				  // temporary array of bytes with 4 elements
-  float data=0;
-  digitalWrite(CS, LOW);                          // start new command sequence
-  SPI.transfer(READ);                             // send READ command
-  SPI.transfer((byte)(address >> 16));            // send high byte of address
-  SPI.transfer((byte)(address >> 8));             // send middle byte of address
-  SPI.transfer((byte)address);                    // send low byte of address
-  for(uint16_t i=0; i<4; i++){
-    temp[i] = SPI.transfer(0x00);                 // read the data byte
-  }
-  digitalWrite(CS, HIGH);                         // set SPI slave select HIGH
-  data = *(float *)&temp;                         // 4 bytes to a float.
-  return data;                                    // https://www.microchip.com/forums/m590535.aspx
+#if defined(SRAMSIMPLE_STATS)
+/************ Statistics ***************************/
+
+/*  Start timing a call of this kind, unless an outer call is already being timed. Returns true if it started */
+bool SRAMsimple::StatStart(byte kind){
+  if(_timing) return false;                       // e.g. Write() calling BeginWrite(): charged to Write()
+  _kind=kind;
+  _timing=true;
+  _start=micros();
+  return true;
 }
 
-/*********** Write and Read a Float Array ************************/
-void SRAMsimple::WriteFloatArray(uint32_t address, float *data, uint16_t big){
-  byte holder[big*4]; 				  // temporary array of bytes with 2 elements
-  uint16_t j=0;
-  for(int i=0;i<big;i++){
-    byte *temp=(byte *)&data[i];                  // split float into 4 bytes
-    holder[j]=temp[0];
-    holder[j+1]=temp[1];
-    holder[j+2]=temp[2];
-    holder[j+3]=temp[3];
-    j+=4;
-  }
-  SetMode(CS,Sequential);                         // set to send/receive multiple bytes of data
-  digitalWrite(CS, LOW);                          // start new command sequence
-  SPI.transfer(WRITE);                            // send WRITE command
-  SPI.transfer((byte)(address >> 16));            // send high byte of address
-  SPI.transfer((byte)(address >> 8));             // send middle byte of address
-  SPI.transfer((byte)address);                    // send low byte of address
-  SPI.transfer(holder, big*4);                    // transfer an array of data => needs array name & size (4 elements)
-  digitalWrite(CS, HIGH);                         // set SPI slave select HIGH
+void SRAMsimple::StatStop(){
+  _stats[_kind].micros+=micros()-_start;
+  _timing=false;
+}
+
+/*  Counters for one kind of call (StatByte ... StatControl) **********/
+SRAMstats SRAMsimple::Stats(byte kind){
+  return _stats[kind];
 }
 
-void SRAMsimple::ReadFloatArray(uint32_t address, float *data, uint16_t big){
-  SetMode(CS,Sequential);                         // set to send/receive multiple bytes of data
-  byte holder[big*4]; 				  // temporary array of bytes
-  byte t[4];                                      // to hold 4 bytes
-  digitalWrite(CS, LOW);                          // start new command sequence
-  SPI.transfer(READ);                             // send READ command
-  SPI.transfer((byte)(address >> 16));            // send high byte of address
-  SPI.transfer((byte)(address >> 8));             // send middle byte of address
-  SPI.transfer((byte)address);                    // send low byte of address
-  for(uint16_t i=0; i<(big*4); i++){
-    holder[i] = SPI.transfer(0x00);               // read the data byte
+/*  All kinds added up */
+SRAMstats SRAMsimple::Stats(){
+  SRAMstats total={0, 0, 0, 0, 0};
+  for(byte k=0; k<StatKinds; k++){
+    total.commands+=_stats[k].commands;
+    total.payload+=_stats[k].payload;
+    total.overhead+=_stats[k].overhead;
+    total.selects+=_stats[k].selects;
+    total.micros+=_stats[k].micros;
   }
-  digitalWrite(CS, HIGH);                         // set SPI slave select HIGH
-  uint16_t j=0;
-  for(int i=0;i<big;i++){ 
-    t[0]=holder[j];
-    t[1]=holder[j+1];
-    t[2]=holder[j+2];
-    t[3]=holder[j+3];
-    data[i] = *(float *)&t;                        // 4 bytes to a float.
-    j+=4;
+  return total;
+}
+
+void SRAMsimple::ResetStats(){
+  memset(_stats, 0, sizeof(_stats));
+}
+
+/*  One line per kind of call, then the total, tab separated **********/
+void SRAMsimple::PrintStats(Print &out){
+  static const char *names[StatKinds+1]={"byte", "value", "array", "stream", "bulk", "control", "total"};
+  out.println("kind\tcommands\tpayload\toverhead\tselects\tus");
+  for(byte k=0; k<=StatKinds; k++){
+    SRAMstats s=(k<StatKinds) ? Stats(k) : Stats();
+    out.print(names[k]);
+    out.print('\t');
+    out.print(s.commands);
+    out.print('\t');
+    out.print(s.payload);
+    out.print('\t');
+    out.print(s.overhead);
+    out.print('\t');
+    out.print(s.selects);
+    out.print('\t');
+    out.println(s.micros);
   }
 }
+#endif
@@ -9,6 +9,7 @@
 
 #include <Arduino.h>
 #include <SPI.h>
+#include "SRAMbus.h"
 
 /************SRAM opcodes: commands to the 23LC1024 memory chip ******************/
 #define RDMR        5       // Read the Mode Register
@@ -16,40 +17,242 @@
 #define READ        3       // Read command
 #define WRITE       2       // Write command
 #define RSTIO     0xFF      // Reset memory to SPI mode
+#define EDIO      0x3B      // Enter dual I/O (SDI) mode
+#define EQIO      0x38      // Enter quad I/O (SQI) mode
 #define ByteMode    0x00    // Byte mode (read/write one byte at a time)
 #define Sequential  0x40    // Sequential mode (read/write blocks of memory)
+#define ModeUnknown 0xFF    // Mode register contents not known: next access re-sends WRMR
+#define SRAMsize    0x20000UL // 128 KB per 23LC1024 chip (addresses 0 to 0x1FFFF)
+#define SRAMpage    32      // page size: Page mode wraps inside it
+#define SRAMmaxClock 20000000UL // fastest SPI clock the 23LC1024 supports (20 MHz)
 
-extern byte CS;		    // Global variable for CS pin (default 10)
+/************ Statistics: what each kind of call costs on the bus ******************
+ * Uncomment the next line (or add -DSRAMSIMPLE_STATS to the build flags) to count commands,
+ * bytes, CS toggles and time, per kind of call. Left off, the counters take no RAM and no time,
+ * and Stats() returns zeros.
+ */
+//#define SRAMSIMPLE_STATS
+
+#define StatByte    0       // WriteByte, ReadByte
+#define StatValue   1       // Write, Read, WriteInt, ReadFloat, ...
+#define StatArray   2       // WriteArray, ReadArray, WriteIntArray, ...
+#define StatStream  3       // BeginWrite/BeginRead ... End called directly (SRAMbank, SRAMcache, ...)
+#define StatBulk    4       // Dump, Restore, Fill, Copy, Compare
+#define StatControl 5       // SetMode, ReadMode, SetBus
+#define StatKinds   6
+
+struct SRAMstats {
+  uint32_t commands;        // READ, WRITE, WRMR, RDMR, RSTIO and EDIO/EQIO commands sent
+  uint32_t payload;         // data bytes moved
+  uint32_t overhead;        // command, address, mode register and dummy bytes
+  uint32_t selects;         // times CS was pulled low
+  uint32_t micros;          // time spent inside the calls
+};
+
+#if defined(SRAMSIMPLE_STATS)
+#define SRAM_STAT_CALL(kind)    StatScope _statScope(this, kind)   // charge this call to kind
+#define SRAM_STAT_ADD(field, n) (_stats[_kind].field+=(n))
+#else
+#define SRAM_STAT_CALL(kind)
+#define SRAM_STAT_ADD(field, n)
+#endif
+
+/************ How values are laid out on the chip ******************
+ * Integers are stored high byte first, the way WriteInt and WriteLong always have.
+ * Everything else (float, structs, ...) is stored byte for byte as it sits in memory.
+ */
+template<class T> inline void SRAMencode(const T &value, byte *out){
+  memcpy(out, &value, sizeof(T));
+}
+template<class T> inline void SRAMdecode(const byte *in, T &value){
+  memcpy(&value, in, sizeof(T));
+}
+/*  One value through an open transaction (anything with Send(byte) and Receive()). Everything but
+ *  the integers goes straight from and to the variable, so a big struct is not copied on the stack */
+template<class T, class Bus> inline void SRAMsend(Bus &bus, const T &value){
+  const byte *p=(const byte *)&value;
+  for(size_t i=0; i<sizeof(T); i++) bus.Send(p[i]);
+}
+template<class T, class Bus> inline void SRAMreceive(Bus &bus, T &value){
+  byte *p=(byte *)&value;
+  for(size_t i=0; i<sizeof(T); i++) p[i]=bus.Receive();
+}
+#define SRAM_HIGH_BYTE_FIRST(T, U)                                                \
+  inline void SRAMencode(const T &value, byte *out){                             \
+    U v=(U)value;                                                                \
+    for(byte i=sizeof(T); i>0; i--){ out[i-1]=(byte)v; v>>=8; }                  \
+  }                                                                              \
+  inline void SRAMdecode(const byte *in, T &value){                              \
+    U v=0;                                                                       \
+    for(byte i=0; i<sizeof(T); i++){ v=(U)((v<<8)|in[i]); }                      \
+    value=(T)v;                                                                  \
+  }                                                                              \
+  template<class Bus> inline void SRAMsend(Bus &bus, const T &value){            \
+    byte temp[sizeof(T)];                                                        \
+    SRAMencode(value, temp);                                                     \
+    for(byte i=0; i<sizeof(T); i++) bus.Send(temp[i]);                           \
+  }                                                                              \
+  template<class Bus> inline void SRAMreceive(Bus &bus, T &value){               \
+    byte temp[sizeof(T)];                                                        \
+    for(byte i=0; i<sizeof(T); i++) temp[i]=bus.Receive();                       \
+    SRAMdecode(temp, value);                                                     \
+  }
+SRAM_HIGH_BYTE_FIRST(short, unsigned short)
+SRAM_HIGH_BYTE_FIRST(unsigned short, unsigned short)
+SRAM_HIGH_BYTE_FIRST(int, unsigned int)
+SRAM_HIGH_BYTE_FIRST(unsigned int, unsigned int)
+SRAM_HIGH_BYTE_FIRST(long, unsigned long)
+SRAM_HIGH_BYTE_FIRST(unsigned long, unsigned long)
+SRAM_HIGH_BYTE_FIRST(long long, unsigned long long)
+SRAM_HIGH_BYTE_FIRST(unsigned long long, unsigned long long)
 
 class SRAMsimple {
   public:
-    SRAMsimple();
+    SRAMsimple(byte CSpin=10);
     ~SRAMsimple();
+    byte GetCS();
+    void SetSPISettings(SPISettings settings);
+    void SetClock(uint32_t clock);
+    void SetBus(SRAMbus *bus);
     void SetMode(byte CSpin, char Mode);
+    char ReadMode();
+    void ResyncMode();
+    void SetSequentialOnly(bool enable);
+    void BeginWrite(uint32_t address);
+    void BeginRead(uint32_t address);
+    void Send(byte data){ SRAM_STAT_ADD(payload, 1); Out(data); }
+    byte Receive(){ SRAM_STAT_ADD(payload, 1); return In(); }
+    void End();
+    void Dump(Print &out, uint32_t address=0, uint32_t big=SRAMsize);
+    uint32_t Restore(Stream &in, uint32_t address=0, uint32_t big=SRAMsize);
+    void Fill(uint32_t address, byte value, uint32_t big);
+    void Copy(uint32_t from, uint32_t to, uint32_t big);
+    bool Compare(uint32_t address, const byte *data, uint32_t big);
+    template<class T> void Write(uint32_t address, const T &data);
+    template<class T> void Read(uint32_t address, T &data);
+    template<class T> T Read(uint32_t address){ T data; Read(address, data); return data; }
+    template<class T> void WriteArray(uint32_t address, const T *data, uint32_t big);
+    template<class T> void ReadArray(uint32_t address, T *data, uint32_t big);
+    template<class T, size_t N> void Write(uint32_t address, const T (&data)[N]){ WriteArray(address, data, N); }
+    template<class T, size_t N> void Read(uint32_t address, T (&data)[N]){ ReadArray(address, data, N); }
     void WriteByte(uint32_t address, byte data_byte);
     byte ReadByte(uint32_t address);
-    void WriteByteArray(uint32_t address, byte *data, uint16_t big);
-    void ReadByteArray(uint32_t address, byte *data, uint16_t big);
-    void WriteInt(uint32_t address, int data);  
-    int ReadInt(uint32_t address);
-    void WriteIntArray(uint32_t address, int *data, uint16_t big);
-    void ReadIntArray(uint32_t address, int *data, uint16_t big);
-    void WriteUnsignedInt(uint32_t address, unsigned int data);
-    unsigned int ReadUnsignedInt(uint32_t address);
-    void WriteUnsignedIntArray(uint32_t address, unsigned int *data, uint16_t big);
-    void ReadUnsignedIntArray(uint32_t address, unsigned int *data, uint16_t big);
-    void WriteLong(uint32_t address, long data);
-    long ReadLong(uint32_t address);
-    void WriteLongArray(uint32_t address, long *data, uint16_t big);
-    void ReadLongArray(uint32_t address, long *data, uint16_t big);
-    void WriteUnsignedLong(uint32_t address, unsigned long data);
-    unsigned long ReadUnsignedLong(uint32_t address);
-    void WriteUnsignedLongArray(uint32_t address, unsigned long *data, uint16_t big);
-    void ReadUnsignedLongArray(uint32_t address, unsigned long *data, uint16_t big);
-    void WriteFloat(uint32_t address, float data);
-    float ReadFloat(uint32_t address);
-    void WriteFloatArray(uint32_t address, float *data, uint16_t big);
-    void ReadFloatArray(uint32_t address, float *data, uint16_t big);
+    void WriteByteArray(uint32_t address, byte *data, uint32_t big){ WriteArray(address, data, big); }
+    void ReadByteArray(uint32_t address, byte *data, uint32_t big){ ReadArray(address, data, big); }
+    void WriteInt(uint32_t address, int data){ Write(address, data); }
+    int ReadInt(uint32_t address){ return Read<int>(address); }
+    void WriteIntArray(uint32_t address, int *data, uint32_t big){ WriteArray(address, data, big); }
+    void ReadIntArray(uint32_t address, int *data, uint32_t big){ ReadArray(address, data, big); }
+    void WriteUnsignedInt(uint32_t address, unsigned int data){ Write(address, data); }
+    unsigned int ReadUnsignedInt(uint32_t address){ return Read<unsigned int>(address); }
+    void WriteUnsignedIntArray(uint32_t address, unsigned int *data, uint32_t big){ WriteArray(address, data, big); }
+    void ReadUnsignedIntArray(uint32_t address, unsigned int *data, uint32_t big){ ReadArray(address, data, big); }
+    void WriteLong(uint32_t address, long data){ Write(address, data); }
+    long ReadLong(uint32_t address){ return Read<long>(address); }
+    void WriteLongArray(uint32_t address, long *data, uint32_t big){ WriteArray(address, data, big); }
+    void ReadLongArray(uint32_t address, long *data, uint32_t big){ ReadArray(address, data, big); }
+    void WriteUnsignedLong(uint32_t address, unsigned long data){ Write(address, data); }
+    unsigned long ReadUnsignedLong(uint32_t address){ return Read<unsigned long>(address); }
+    void WriteUnsignedLongArray(uint32_t address, unsigned long *data, uint32_t big){ WriteArray(address, data, big); }
+    void ReadUnsignedLongArray(uint32_t address, unsigned long *data, uint32_t big){ ReadArray(address, data, big); }
+    void WriteFloat(uint32_t address, float data){ Write(address, data); }
+    float ReadFloat(uint32_t address){ return Read<float>(address); }
+    void WriteFloatArray(uint32_t address, float *data, uint32_t big){ WriteArray(address, data, big); }
+    void ReadFloatArray(uint32_t address, float *data, uint32_t big){ ReadArray(address, data, big); }
+#if defined(SRAMSIMPLE_STATS)
+    SRAMstats Stats(byte kind);
+    SRAMstats Stats();
+    void ResetStats();
+    void PrintStats(Print &out);
+#else
+    SRAMstats Stats(byte){ SRAMstats none={0, 0, 0, 0, 0}; return none; }
+    SRAMstats Stats(){ return Stats(0); }
+    void ResetStats(){}
+    void PrintStats(Print &out){ out.println("SRAMSIMPLE_STATS is not defined"); }
+#endif
+  private:
+    friend class SRAMasync;
+    void UseMode(char Mode);
+    void Select();
+    void Deselect();
+    void CSLow(){
+#if defined(__AVR__)
+      uint8_t oldSREG=SREG;   // direct port write, read-modify-write: an ISR writing another pin
+      cli();                  // of this port in between would be undone, so keep interrupts out
+      *_csPort &= ~_csMask;
+      SREG=oldSREG;
+#else
+      digitalWrite(_cs, LOW);
+#endif
+    }
+    void CSHigh(){
+#if defined(__AVR__)
+      uint8_t oldSREG=SREG;   // as in CSLow()
+      cli();
+      *_csPort |= _csMask;
+      SREG=oldSREG;
+#else
+      digitalWrite(_cs, HIGH);
+#endif
+    }
+    void Out(byte data){ if(_bus) _bus->Send(data); else SPI.transfer(data); }
+    byte In(){ return _bus ? _bus->Receive() : SPI.transfer(0x00); }
+    void Command(byte command, uint32_t address);
+#if defined(SRAMSIMPLE_STATS)
+    class StatScope {         // times a call, if no outer call is being timed already
+      public:
+        StatScope(SRAMsimple *sram, byte kind){ _sram=sram; _outer=sram->StatStart(kind); }
+        ~StatScope(){ if(_outer) _sram->StatStop(); }
+      private:
+        SRAMsimple *_sram;
+        bool _outer;
+    };
+    bool StatStart(byte kind);
+    void StatStop();
+    SRAMstats _stats[StatKinds];
+    byte _kind;             // kind of call the bytes on the bus are charged to
+    bool _timing;           // a call is being timed
+    uint32_t _start;        // micros() when it started
+#endif
+    byte _cs;               // chip select pin for this chip (default 10)
+    SPISettings _settings;  // SPI clock, bit order and data mode used for this chip
+    SRAMbus *_bus;          // other pins or a wider bus, or 0 for the hardware SPI
+#if defined(__AVR__)
+    volatile uint8_t *_csPort;  // output register of the CS pin, so CS can be toggled directly
+    uint8_t _csMask;        // bit for the CS pin in that register
+#endif
+    byte _mode;             // shadow of the chip's mode register (ModeUnknown until first WRMR)
+    bool _seqOnly;          // true: keep the chip in Sequential mode, even for single bytes
 };
 
+/************ Any type: sizeof(T) is known at compile time, so the byte loops unroll *********/
+template<class T> void SRAMsimple::Write(uint32_t address, const T &data){
+  SRAM_STAT_CALL(StatValue);
+  BeginWrite(address);
+  SRAMsend(*this, data);
+  End();
+}
+
+template<class T> void SRAMsimple::Read(uint32_t address, T &data){
+  SRAM_STAT_CALL(StatValue);
+  BeginRead(address);
+  SRAMreceive(*this, data);
+  End();
+}
+
+/************ Arrays of any type: one element at a time, inside one transaction ************/
+template<class T> void SRAMsimple::WriteArray(uint32_t address, const T *data, uint32_t big){
+  SRAM_STAT_CALL(StatArray);
+  BeginWrite(address);
+  for(uint32_t i=0; i<big; i++) SRAMsend(*this, data[i]);
+  End();
+}
+
+template<class T> void SRAMsimple::ReadArray(uint32_t address, T *data, uint32_t big){
+  SRAM_STAT_CALL(StatArray);
+  BeginRead(address);
+  for(uint32_t i=0; i<big; i++) SRAMreceive(*this, data[i]);
+  End();
+}
+
 #endif
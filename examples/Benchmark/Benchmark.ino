@@ -0,0 +1,160 @@
+/* Example program for use with SRAMsimple.h - throughput of every Write/Read function
+    Arduino Uno Memory Expansion Sample Program
+    Library created and expanded by: D. Dubins 12-Nov-18
+
+   Times every Write and Read function of the library, for single values and for arrays of
+   1 to 4096 elements, at three kinds of addresses:
+     seq       - one after the other, starting on a 32-byte page boundary
+     unaligned - one after the other, starting 13 bytes into a page
+     random    - anywhere on the chip
+   Results are printed over Serial as CSV, one line per test:
+     api,pattern,elements,ops,payload_bytes,us,us_per_op,bytes_per_s,overhead_ratio
+   overhead_ratio is the share of SPI bytes that are not data (commands, addresses and
+   mode register writes). On the board it is counted by the library if SRAMSIMPLE_STATS is
+   defined (which adds a little time to every call); otherwise it is worked out as a command
+   and 3 address bytes per call, with no mode register writes: the first call of each test,
+   which may have to set the mode, is not timed, and the rest find the mode already set.
+   Arrays that don't fit in BUF_BYTES of RAM are skipped.
+
+   Also runs on Linux against the 23LC1024 emulator in extras/host (see README.md). There,
+   the times are modeled bus time, and overhead_ratio is counted on the emulated bus.
+
+   Used the following components:
+   (1) Arduino Uno
+   (2) Microchip 23LC1024 SPI SRAM chip
+
+   Wiring:
+   23LC1024 - Uno:
+   ---------------
+   Pin1 (JSC) -- Pin 10 (CS) (with 10K pullup to +5V)
+   Pin2 (SO)  -- Pin 12 (MISO)
+   Pin3 (NU)  -- 10K -- +5V
+   Pin4 (GND) -- GND
+   Pin5 (SI)  -- Pin 11 (MOSI)
+   Pin6 (SCK) -- Pin 13 (SCK)
+   Pin7 (HOLD) -- 10K -- +5V
+   Pin8 (V+)  -- +5V
+*/
+
+#include <SRAMsimple.h>
+#ifdef SRAM_HOST
+#include "SRAM23LC1024.h"      // emulator counters, when built on Linux
+#define BUF_BYTES 16384        // room for 4096 floats
+#else
+#define BUF_BYTES 1024         // what an Uno can spare
+#endif
+
+#define CSPIN 10               // Default Chip Select Line for Uno (change as needed)
+#define MIN_PAYLOAD 8192       // move at least this many bytes per test...
+#define MIN_OPS 16             // ...and do at least this many calls
+
+#define SEQ       0
+#define UNALIGNED 1
+#define RANDOM    2
+const char *patternName[3] = {"seq", "unaligned", "random"};
+
+SRAMsimple sram(CSPIN);        // initialize an instance of this class on chip select CSPIN
+
+float buf[BUF_BYTES/sizeof(float)];   // data to write and space to read (float: aligned for any type)
+uint16_t rng = 1;              // xorshift state for random addresses
+
+/*  Address of call number i, for calls that move 'span' bytes each **********/
+uint32_t address(byte pattern, uint16_t i, uint32_t span){
+  uint32_t slots = (SRAMsize-64)/span;          // calls that fit on the chip
+  if(pattern==RANDOM){
+    rng ^= rng << 7; rng ^= rng >> 9; rng ^= rng << 8;   // cheap, so it doesn't skew the timing
+    return ((uint32_t)rng*17) % (SRAMsize-span);
+  }
+  uint32_t a = (i % slots)*span;                // one after the other, from 0 (a page boundary)
+  return (pattern==UNALIGNED) ? a+13 : a;
+}
+
+/*  Run op(i, address) enough times, then print one CSV line **********/
+template<class F> void timeIt(const char *api, byte pattern, uint16_t elements, uint16_t elementSize, F op){
+  uint32_t span = (uint32_t)elements*elementSize;  // payload bytes per call
+  if(span > BUF_BYTES) return;                  // doesn't fit in RAM here
+  uint16_t ops = MIN_PAYLOAD/span;
+  if(ops < MIN_OPS) ops = MIN_OPS;
+  rng = 1;
+  op(0, address(pattern, 0, span));             // first call may set the mode register: keep it out
+#ifdef SRAM_HOST
+  SRAMemu::ResetCounters();
+#endif
+  sram.ResetStats();
+  rng = 1;
+  unsigned long t = micros();
+  for(uint16_t i=0; i<ops; i++){
+    op(i, address(pattern, i, span));
+  }
+  unsigned long us = micros()-t;
+  uint32_t payload = span*ops;
+#if defined(SRAM_HOST)
+  float overhead = 1.0 - (float)payload/SRAMemu::SpiBytes();       // counted on the bus
+#elif defined(SRAMSIMPLE_STATS)
+  SRAMstats s = sram.Stats();
+  float overhead = (float)s.overhead/(s.payload+s.overhead);       // counted by the library
+#else
+  float overhead = 4.0/(4.0+span);              // command + 3 address bytes per call, no WRMR
+#endif
+  Serial.print(api); Serial.print(',');
+  Serial.print(patternName[pattern]); Serial.print(',');
+  Serial.print(elements); Serial.print(',');
+  Serial.print(ops); Serial.print(',');
+  Serial.print(payload); Serial.print(',');
+  Serial.print(us); Serial.print(',');
+  Serial.print((float)us/ops, 3); Serial.print(',');
+  Serial.print(us ? payload*1000000.0/us : 0.0, 0); Serial.print(',');
+  Serial.println(overhead, 4);
+}
+
+/*  Single values, every type **********/
+void scalars(byte p){
+  timeIt("WriteByte", p, 1, 1, [](uint16_t i, uint32_t a){ sram.WriteByte(a, (byte)i); });
+  timeIt("ReadByte", p, 1, 1, [](uint16_t, uint32_t a){ sram.ReadByte(a); });
+  timeIt("WriteInt", p, 1, sizeof(int), [](uint16_t i, uint32_t a){ sram.WriteInt(a, (int)i); });
+  timeIt("ReadInt", p, 1, sizeof(int), [](uint16_t, uint32_t a){ sram.ReadInt(a); });
+  timeIt("WriteUnsignedInt", p, 1, sizeof(unsigned int), [](uint16_t i, uint32_t a){ sram.WriteUnsignedInt(a, i); });
+  timeIt("ReadUnsignedInt", p, 1, sizeof(unsigned int), [](uint16_t, uint32_t a){ sram.ReadUnsignedInt(a); });
+  timeIt("WriteLong", p, 1, sizeof(long), [](uint16_t i, uint32_t a){ sram.WriteLong(a, (long)i); });
+  timeIt("ReadLong", p, 1, sizeof(long), [](uint16_t, uint32_t a){ sram.ReadLong(a); });
+  timeIt("WriteUnsignedLong", p, 1, sizeof(unsigned long), [](uint16_t i, uint32_t a){ sram.WriteUnsignedLong(a, i); });
+  timeIt("ReadUnsignedLong", p, 1, sizeof(unsigned long), [](uint16_t, uint32_t a){ sram.ReadUnsignedLong(a); });
+  timeIt("WriteFloat", p, 1, sizeof(float), [](uint16_t i, uint32_t a){ sram.WriteFloat(a, (float)i); });
+  timeIt("ReadFloat", p, 1, sizeof(float), [](uint16_t, uint32_t a){ sram.ReadFloat(a); });
+}
+
+/*  Arrays of n elements, every type **********/
+uint16_t n;                    // array length for the current test (global, so the lambdas need no captures)
+
+void arrays(byte p){
+  timeIt("WriteByteArray", p, n, 1, [](uint16_t, uint32_t a){ sram.WriteByteArray(a, (byte *)buf, n); });
+  timeIt("ReadByteArray", p, n, 1, [](uint16_t, uint32_t a){ sram.ReadByteArray(a, (byte *)buf, n); });
+  timeIt("WriteIntArray", p, n, sizeof(int), [](uint16_t, uint32_t a){ sram.WriteIntArray(a, (int *)buf, n); });
+  timeIt("ReadIntArray", p, n, sizeof(int), [](uint16_t, uint32_t a){ sram.ReadIntArray(a, (int *)buf, n); });
+  timeIt("WriteUnsignedIntArray", p, n, sizeof(unsigned int), [](uint16_t, uint32_t a){ sram.WriteUnsignedIntArray(a, (unsigned int *)buf, n); });
+  timeIt("ReadUnsignedIntArray", p, n, sizeof(unsigned int), [](uint16_t, uint32_t a){ sram.ReadUnsignedIntArray(a, (unsigned int *)buf, n); });
+  timeIt("WriteLongArray", p, n, sizeof(long), [](uint16_t, uint32_t a){ sram.WriteLongArray(a, (long *)buf, n); });
+  timeIt("ReadLongArray", p, n, sizeof(long), [](uint16_t, uint32_t a){ sram.ReadLongArray(a, (long *)buf, n); });
+  timeIt("WriteUnsignedLongArray", p, n, sizeof(unsigned long), [](uint16_t, uint32_t a){ sram.WriteUnsignedLongArray(a, (unsigned long *)buf, n); });
+  timeIt("ReadUnsignedLongArray", p, n, sizeof(unsigned long), [](uint16_t, uint32_t a){ sram.ReadUnsignedLongArray(a, (unsigned long *)buf, n); });
+  timeIt("WriteFloatArray", p, n, sizeof(float), [](uint16_t, uint32_t a){ sram.WriteFloatArray(a, buf, n); });
+  timeIt("ReadFloatArray", p, n, sizeof(float), [](uint16_t, uint32_t a){ sram.ReadFloatArray(a, buf, n); });
+}
+
+void setup()
+{
+  Serial.begin(115200);                       // lots of output: go fast
+  SPI.begin();                                // start communicating with the memory chip
+  for(uint16_t i=0; i<BUF_BYTES/sizeof(float); i++) buf[i]=i*0.5;  // some data to send
+
+  Serial.println("api,pattern,elements,ops,payload_bytes,us,us_per_op,bytes_per_s,overhead_ratio");
+  for(byte p=SEQ; p<=RANDOM; p++) scalars(p);
+  for(n=1; n<=4096; n*=4){                    // 1, 4, 16, 64, 256, 1024, 4096 elements
+    for(byte p=SEQ; p<=RANDOM; p++) arrays(p);
+  }
+  Serial.println("done");
+}
+
+void loop()
+{
+}
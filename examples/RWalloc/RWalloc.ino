@@ -0,0 +1,88 @@
+/* Example program for use with SRAMalloc.h - letting the library pick the addresses
+    Arduino Uno Memory Expansion Sample Program
+    Library created and expanded by: D. Dubins 12-Nov-18
+
+   An arena carves the chip into a pool of 32-byte records and a scratch area. Records come
+   and go through the pool; the scratch area is used for one "frame" of work and then freed
+   all at once with Reset(). The handles are chip addresses: Write and Read take them as is.
+
+   Used the following components:
+   (1) Arduino Uno
+   (2) Microchip 23LC1024 SPI SRAM chip
+
+   Wiring:
+   23LC1024 - Uno:
+   ---------------
+   Pin1 (JSC) -- Pin 10 (CS) (with 10K pullup to +5V)
+   Pin2 (SO)  -- Pin 12 (MISO)
+   Pin3 (NU)  -- 10K -- +5V
+   Pin4 (GND) -- GND
+   Pin5 (SI)  -- Pin 11 (MOSI)
+   Pin6 (SCK) -- Pin 13 (SCK)
+   Pin7 (HOLD) -- 10K -- +5V
+   Pin8 (V+)  -- +5V
+*/
+
+#include <SRAMalloc.h>
+
+#define CSPIN 10       // Default Chip Select Line for Uno (change as needed)
+
+struct contact {       // one record
+  char name[16];
+  long phone;
+  int age;
+};
+
+SRAMsimple sram(CSPIN);                       // initialize an instance of this class on chip select CSPIN
+SRAMarena chip(0, SRAMsize);                  // the whole chip
+SRAMpool<> contacts(sram, chip.Alloc(1000*32UL, SRAMpage), sizeof(contact), 1000, true);  // 1000 records, one page each
+SRAMarena scratch(chip.Alloc(16384), 16384);  // 16 kB for temporary data
+
+void setup()
+{
+  Serial.begin(9600);                         // set communication speed for the serial monitor
+  SPI.begin();                                // start communicating with the memory chip
+
+/************ Records come and go *******************/
+  uint32_t bob = contacts.Alloc();
+  uint32_t amy = contacts.Alloc();
+  contact c = {"Bob", 5551234L, 42};
+  sram.Write(bob, c);
+  contact d = {"Amy", 5559876L, 37};
+  sram.Write(amy, d);
+  contacts.Free(bob);                         // Bob's block goes back to the pool...
+  uint32_t cal = contacts.Alloc();            // ...and is the next one handed out
+  Serial.print("Bob was at ");
+  Serial.print(bob);
+  Serial.print(", Cal is at ");
+  Serial.println(cal);
+  sram.Read(amy, d);
+  Serial.print("Amy's phone: ");
+  Serial.println(d.phone);
+  Serial.print("Records in use: ");
+  Serial.print(contacts.InUse());
+  Serial.print(" of ");
+  Serial.println(contacts.Blocks());
+
+/************ A frame of scratch work, freed all at once **********/
+  for(byte frame=0; frame<3; frame++){
+    uint32_t samples = scratch.Alloc(100*sizeof(int));
+    uint32_t table = scratch.Alloc(10*sizeof(float), SRAMpage);  // start on a page
+    for(int i=0; i<100; i++) sram.WriteInt(samples+i*sizeof(int), i*frame);
+    for(int i=0; i<10; i++) sram.WriteFloat(table+i*sizeof(float), i*0.5);
+    Serial.print("Frame ");
+    Serial.print(frame);
+    Serial.print(": scratch used ");
+    Serial.print(scratch.Used());
+    Serial.print(" bytes, ");
+    Serial.print(scratch.Padding());
+    Serial.println(" of them padding");
+    scratch.Reset();
+  }
+  Serial.print("Chip left unassigned: ");
+  Serial.println(chip.Free());
+}
+
+void loop()
+{
+}
@@ -0,0 +1,82 @@
+/* Example program for use with SRAMarray.h - a big array on the chip, used like a normal one
+    Arduino Uno Memory Expansion Sample Program
+    Library created and expanded by: D. Dubins 12-Nov-18
+
+   Keeps 10000 float samples on the 23LC1024, far more than the Uno's 2 kB of RAM, and works
+   on them with plain a[i] and range-for loops. SRAMarray moves 16 values per command behind
+   the scenes. The average is worked out twice: with one ReadFloat call per sample, and
+   through the array, to compare the time.
+
+   Used the following components:
+   (1) Arduino Uno
+   (2) Microchip 23LC1024 SPI SRAM chip
+
+   Wiring:
+   23LC1024 - Uno:
+   ---------------
+   Pin1 (JSC) -- Pin 10 (CS) (with 10K pullup to +5V)
+   Pin2 (SO)  -- Pin 12 (MISO)
+   Pin3 (NU)  -- 10K -- +5V
+   Pin4 (GND) -- GND
+   Pin5 (SI)  -- Pin 11 (MOSI)
+   Pin6 (SCK) -- Pin 13 (SCK)
+   Pin7 (HOLD) -- 10K -- +5V
+   Pin8 (V+)  -- +5V
+*/
+
+#include <SRAMarray.h>
+
+#define CSPIN 10       // Default Chip Select Line for Uno (change as needed)
+#define SAMPLES 10000
+
+SRAMsimple sram(CSPIN);                           // initialize an instance of this class on chip select CSPIN
+SRAMarray<float, 16> raw(sram, 0, SAMPLES);       // 40000 bytes on the chip, 64 bytes of RAM
+SRAMarray<float, 16> smooth(sram, 40000, SAMPLES);
+
+void setup()
+{
+  Serial.begin(9600);                             // set communication speed for the serial monitor
+  SPI.begin();                                    // start communicating with the memory chip
+
+/************ Fill it like any array *******************/
+  for(uint32_t i=0; i<SAMPLES; i++){
+    raw[i] = (i%100)*0.1;                         // a saw tooth
+  }
+  raw.Flush();                                    // last window to the chip, before ReadFloat below
+
+/************ Average, one ReadFloat per sample **********/
+  unsigned long t = micros();
+  float sum = 0;
+  for(uint32_t i=0; i<SAMPLES; i++) sum += sram.ReadFloat(i*sizeof(float));
+  t = micros()-t;
+  Serial.print("ReadFloat loop: average ");
+  Serial.print(sum/SAMPLES, 4);
+  Serial.print(", ");
+  Serial.print(t);
+  Serial.println(" us");
+
+/************ Average, through the array **********/
+  t = micros();
+  sum = 0;
+  for(float x : raw) sum += x;
+  t = micros()-t;
+  Serial.print("SRAMarray loop: average ");
+  Serial.print(sum/SAMPLES, 4);
+  Serial.print(", ");
+  Serial.print(t);
+  Serial.println(" us");
+
+/************ 3-point moving average into a second array **********/
+  smooth[0] = raw[0];
+  for(uint32_t i=1; i<SAMPLES-1; i++){
+    smooth[i] = (raw[i-1]+raw[i]+raw[i+1])/3;
+  }
+  smooth[SAMPLES-1] = raw[SAMPLES-1];
+  smooth.Flush();
+  Serial.print("Smoothed sample 100: ");
+  Serial.println((float)smooth[100], 4);          // (9.9 + 0 + 0.1)/3
+}
+
+void loop()
+{
+}
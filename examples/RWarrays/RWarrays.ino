@@ -29,7 +29,7 @@
 
 #define CSPIN 10       // Default Chip Select Line for Uno (change as needed)
 
-SRAMsimple sram;       // initialize an instance of this class
+SRAMsimple sram(CSPIN); // initialize an instance of this class on chip select CSPIN
 
 /*******************  Create some dummy data to read and space to write  ******************/
 byte a[20] = {"abcdefghijklmnopqrs"};         // array data to write
@@ -48,9 +48,6 @@ float read_data_f[5];                         // array to hold data read from me
 
 void setup()
 {
-  uint32_t address = 0;                       // create a 32 bit variable to hold the address (uint32_t=long)
-  byte value;                                 // create variable to hold the data value read
-  byte data;                                  // create variable to hold the data value sent
   Serial.begin(9600);                         // set communication speed for the serial monitor
   SPI.begin();                                // start communicating with the memory chip
     
@@ -61,7 +58,7 @@ void setup()
 /************ Read a Sequence of Bytes from Memory into an Array **********/
   Serial.println("Reading byte array using sequential: ");
   sram.ReadByteArray(0, read_data_a, sizeof(read_data_a));   // Read array into read_data_a starting at address 0
-  for(int i=0; i<sizeof(read_data_a); i++){     // print the array
+  for(unsigned int i=0; i<sizeof(read_data_a); i++){     // print the array
     Serial.println((char)read_data_a[i]);       // We need to cast it as a char
   }                                             // to make it print as a character
 
@@ -0,0 +1,78 @@
+/* Example program for use with SRAMasync.h - reading and writing in the background
+    Arduino Uno Memory Expansion Sample Program
+    Library created and expanded by: D. Dubins 12-Nov-18
+
+   WriteAsync and ReadAsync return right away. On the Uno the SPI interrupt moves the bytes
+   while the sketch keeps working; here it counts how many analogRead() samples it took
+   while a 256-byte block went to the chip and came back. On other boards, call Poll() in the
+   loop to move the transfer along.
+   While a transfer is running, nothing else may use the SPI bus.
+
+   Used the following components:
+   (1) Arduino Uno
+   (2) Microchip 23LC1024 SPI SRAM chip
+
+   Wiring:
+   23LC1024 - Uno:
+   ---------------
+   Pin1 (JSC) -- Pin 10 (CS) (with 10K pullup to +5V)
+   Pin2 (SO)  -- Pin 12 (MISO)
+   Pin3 (NU)  -- 10K -- +5V
+   Pin4 (GND) -- GND
+   Pin5 (SI)  -- Pin 11 (MOSI)
+   Pin6 (SCK) -- Pin 13 (SCK)
+   Pin7 (HOLD) -- 10K -- +5V
+   Pin8 (V+)  -- +5V
+*/
+
+#include <SRAMasync.h>
+
+#define CSPIN 10       // Default Chip Select Line for Uno (change as needed)
+#define BLOCK 256      // bytes per transfer (both buffers have to fit in the Uno's 2 KB of RAM)
+
+SRAMsimple sram(CSPIN); // initialize an instance of this class on chip select CSPIN
+SRAMasync async(sram);  // background transfers on that chip
+SRAMASYNC_DEFINE_ISR()  // the SPI interrupt feeds SRAMasync (on AVR)
+
+byte out[BLOCK];        // data to write
+byte in[BLOCK];         // space to read
+volatile bool readDone = false;
+
+void whenRead(SRAMhandle){         // runs in the SPI interrupt on the Uno: keep it short
+  readDone = true;
+}
+
+void setup()
+{
+  Serial.begin(9600);                         // set communication speed for the serial monitor
+  SPI.begin();                                // start communicating with the memory chip
+  for(int i=0; i<BLOCK; i++) out[i]=(byte)(i*3);
+
+/************  Queue a write and a read, then get on with other work *******************/
+  SRAMhandle w = async.WriteAsync(0, out, BLOCK);             // poll this one with Done()
+  async.ReadAsync(0, in, BLOCK, whenRead);                    // this one calls whenRead()
+
+  unsigned long samples = 0;
+  while(!readDone){
+    async.Poll();                             // moves the transfer along on boards without the interrupt engine
+    analogRead(A0);                           // "other work"
+    samples++;
+  }
+
+  Serial.print("Samples taken during the transfers: ");
+  Serial.println(samples);
+  Serial.print("Write finished: ");
+  Serial.println(async.Done(w) ? "yes" : "no");  // requests run in order, so yes
+
+/************ Check what came back **********/
+  int bad = 0;
+  for(int i=0; i<BLOCK; i++){
+    if(in[i]!=out[i]) bad++;
+  }
+  Serial.print("Bytes that differ: ");
+  Serial.println(bad);
+}
+
+void loop()
+{
+}
@@ -0,0 +1,65 @@
+/* Example program for use with SRAMbank.h - two 23LC1024 chips as one 256kB memory
+    Arduino Uno Memory Expansion Sample Program
+    Library created and expanded by: D. Dubins 12-Nov-18
+
+   Each 23LC1024 gets its own chip select line. SRAMbank maps one linear address onto
+   the chips: chip 0 holds addresses 0 to 0x1FFFF, chip 1 holds 0x20000 to 0x3FFFF.
+   Arrays that run off the end of one chip are continued on the next one.
+
+   Used the following components:
+   (1) Arduino Uno
+   (2) Two Microchip 23LC1024 SPI SRAM chips
+
+   Wiring (both chips share SO, SI and SCK):
+   23LC1024 - Uno:
+   ---------------
+   Pin1 (JSC) -- Pin 10 (CS) for chip 0, Pin 9 (CS) for chip 1 (each with 10K pullup to +5V)
+   Pin2 (SO)  -- Pin 12 (MISO)
+   Pin3 (NU)  -- 10K -- +5V
+   Pin4 (GND) -- GND
+   Pin5 (SI)  -- Pin 11 (MOSI)
+   Pin6 (SCK) -- Pin 13 (SCK)
+   Pin7 (HOLD) -- 10K -- +5V
+   Pin8 (V+)  -- +5V
+*/
+
+#include <SRAMbank.h>
+
+#define CSPIN0 10      // Chip Select Line for chip 0
+#define CSPIN1 9       // Chip Select Line for chip 1
+
+SRAMsimple chips[2] = {SRAMsimple(CSPIN0), SRAMsimple(CSPIN1)};  // one instance per chip
+SRAMbank bank(chips, 2);                     // both chips as one 256kB memory
+
+byte a[20] = {"abcdefghijklmnopqrs"};        // array data to write
+byte read_data_a[20];                        // array to hold data read from memory
+
+void setup()
+{
+  Serial.begin(9600);                        // set communication speed for the serial monitor
+  SPI.begin();                               // start communicating with the memory chips
+
+  Serial.print("Bank size in bytes: ");
+  Serial.println(bank.Size());
+
+/************  Write an array across the boundary between chip 0 and chip 1 *******************/
+  uint32_t address = 0x20000 - 10;           // last 10 bytes of chip 0
+  Serial.println("\nWriting byte array across the chip boundary: ");
+  bank.WriteByteArray(address, a, sizeof(a)); // first 10 bytes go to chip 0, the rest to chip 1
+
+/************ Read it back in one call **********/
+  Serial.println("Reading byte array across the chip boundary: ");
+  bank.ReadByteArray(address, read_data_a, sizeof(read_data_a));
+  for(unsigned int i=0; i<sizeof(read_data_a); i++){  // print the array
+    Serial.print((char)read_data_a[i]);      // We need to cast it as a char
+  }
+  Serial.println();
+
+/************ Each chip can still be used on its own **********/
+  Serial.println("\nReading the start of chip 1 directly: ");
+  Serial.println((char)chips[1].ReadByte(0)); // 11th byte of the array ('k')
+}
+
+void loop()
+{
+}
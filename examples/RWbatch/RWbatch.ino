@@ -0,0 +1,94 @@
+/* Example program for use with SRAMbatch.h - many small reads in a few commands
+    Arduino Uno Memory Expansion Sample Program
+    Library created and expanded by: D. Dubins 12-Nov-18
+
+   Stores 16 records on the chip, then reads two fields (id and reading) of every record,
+   first with one ReadInt/ReadFloat call per field, then as one batch. The batch sorts the
+   reads and joins the ones that are close together, so it needs a fraction of the commands.
+
+   Used the following components:
+   (1) Arduino Uno
+   (2) Microchip 23LC1024 SPI SRAM chip
+
+   Wiring:
+   23LC1024 - Uno:
+   ---------------
+   Pin1 (JSC) -- Pin 10 (CS) (with 10K pullup to +5V)
+   Pin2 (SO)  -- Pin 12 (MISO)
+   Pin3 (NU)  -- 10K -- +5V
+   Pin4 (GND) -- GND
+   Pin5 (SI)  -- Pin 11 (MOSI)
+   Pin6 (SCK) -- Pin 13 (SCK)
+   Pin7 (HOLD) -- 10K -- +5V
+   Pin8 (V+)  -- +5V
+*/
+
+#include <SRAMbatch.h>
+
+#define CSPIN 10       // Default Chip Select Line for Uno (change as needed)
+#define RECORDS 16
+
+struct record {        // one record on the chip
+  int id;
+  float reading;
+  long time;
+};
+
+SRAMsimple sram(CSPIN);             // initialize an instance of this class on chip select CSPIN
+SRAMbatch<2*RECORDS> batch(sram, sizeof(long));  // room for 32 reads; skip up to a long between them
+
+int id[RECORDS];
+float reading[RECORDS];
+
+uint32_t at(int i){ return (uint32_t)i*sizeof(record); }   // address of record i
+
+void setup()
+{
+  Serial.begin(9600);                         // set communication speed for the serial monitor
+  SPI.begin();                                // start communicating with the memory chip
+  for(int i=0; i<RECORDS; i++){              // field by field, so ReadInt/ReadFloat read them back
+    sram.WriteInt(at(i), i);
+    sram.WriteFloat(at(i)+sizeof(int), i*1.5);
+    sram.WriteLong(at(i)+sizeof(int)+sizeof(float), i*1000L);
+  }
+
+/************ One call per field *******************/
+  unsigned long t = micros();
+  for(int i=0; i<RECORDS; i++){
+    id[i] = sram.ReadInt(at(i));
+    reading[i] = sram.ReadFloat(at(i)+sizeof(int));
+  }
+  t = micros()-t;
+  Serial.print("One call per field: ");
+  Serial.print(2*RECORDS);
+  Serial.print(" commands, ");
+  Serial.print(t);
+  Serial.println(" us");
+
+/************ The same reads as one batch **********/
+  memset(id, 0, sizeof(id));
+  memset(reading, 0, sizeof(reading));
+  t = micros();
+  for(int i=RECORDS-1; i>=0; i--){            // any order: Run() sorts them
+    batch.Read(at(i), id[i]);
+    batch.Read(at(i)+sizeof(int), reading[i]);
+  }
+  byte commands = batch.Run();                // the time field in between is clocked past, not a new command
+  t = micros()-t;
+  Serial.print("Batch: ");
+  Serial.print(commands);
+  Serial.print(" commands, ");
+  Serial.print(t);
+  Serial.println(" us");
+
+  int bad = 0;
+  for(int i=0; i<RECORDS; i++){
+    if(id[i]!=i || reading[i]!=i*1.5) bad++;
+  }
+  Serial.print("Records that differ: ");
+  Serial.println(bad);
+}
+
+void loop()
+{
+}
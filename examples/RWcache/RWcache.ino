@@ -0,0 +1,70 @@
+/* Example program for use with SRAMcache.h - a small write-back cache in front of the 23LC1024
+    Arduino Uno Memory Expansion Sample Program
+    Library created and expanded by: D. Dubins 12-Nov-18
+
+   Many small reads and writes close to each other are served from a few 32-byte lines
+   kept in the Uno's RAM, instead of sending a command and 3 address bytes for each one.
+   Changed lines are written back in one sequential transfer when they are evicted,
+   or when Flush() is called.
+
+   Used the following components:
+   (1) Arduino Uno
+   (2) Microchip 23LC1024 SPI SRAM chip
+
+   Wiring:
+   23LC1024 - Uno:
+   ---------------
+   Pin1 (JSC) -- Pin 10 (CS) (with 10K pullup to +5V)
+   Pin2 (SO)  -- Pin 12 (MISO)
+   Pin3 (NU)  -- 10K -- +5V
+   Pin4 (GND) -- GND
+   Pin5 (SI)  -- Pin 11 (MOSI)
+   Pin6 (SCK) -- Pin 13 (SCK)
+   Pin7 (HOLD) -- 10K -- +5V
+   Pin8 (V+)  -- +5V
+*/
+
+#include <SRAMcache.h>
+
+#define CSPIN 10       // Default Chip Select Line for Uno (change as needed)
+
+SRAMsimple sram(CSPIN);             // initialize an instance of this class on chip select CSPIN
+SRAMcache<4, 32> cache(sram);       // 4 lines of 32 bytes: 152 bytes of RAM
+
+void setup()
+{
+  Serial.begin(9600);                         // set communication speed for the serial monitor
+  SPI.begin();                                // start communicating with the memory chip
+
+/************  Write 100 integers one at a time, through the cache *******************/
+  Serial.println("\nWriting 100 integers through the cache: ");
+  for(int i=0; i<100; i++){
+    cache.Write(i*sizeof(int), i*10);         // each write lands in a cached line
+  }
+  cache.Flush();                              // make sure everything is on the chip
+
+/************ Running sum of neighbouring values: lots of small, local reads **********/
+  Serial.println("Summing neighbours through the cache: ");
+  long sum=0;
+  for(int i=1; i<99; i++){
+    sum+=cache.Read<int>((i-1)*sizeof(int));
+    sum+=cache.Read<int>(i*sizeof(int));
+    sum+=cache.Read<int>((i+1)*sizeof(int));
+  }
+  Serial.println(sum);
+
+  Serial.print("Hits: ");
+  Serial.println(cache.Hits());
+  Serial.print("Misses: ");
+  Serial.println(cache.Misses());
+  Serial.print("Lines written back: ");
+  Serial.println(cache.WriteBacks());
+
+/************ The data really is on the chip **********/
+  Serial.println("Reading integer 50 straight from the chip: ");
+  Serial.println(sram.ReadInt(50*sizeof(int)));
+}
+
+void loop()
+{
+}
@@ -0,0 +1,63 @@
+/* Example program for use with SRAMcheck.h - calibration data stored with a CRC
+    Arduino Uno Memory Expansion Sample Program
+    Library created and expanded by: D. Dubins 12-Nov-18
+
+   A table of floats is written with a CRC-16 right after it. Reading it back checks the
+   CRC in the same pass, and says so if the data was damaged. To show that, one byte of
+   the table is then changed behind SRAMcheck's back, and the next read fails.
+
+   Used the following components:
+   (1) Arduino Uno
+   (2) Microchip 23LC1024 SPI SRAM chip
+
+   Wiring:
+   23LC1024 - Uno:
+   ---------------
+   Pin1 (JSC) -- Pin 10 (CS) (with 10K pullup to +5V)
+   Pin2 (SO)  -- Pin 12 (MISO)
+   Pin3 (NU)  -- 10K -- +5V
+   Pin4 (GND) -- GND
+   Pin5 (SI)  -- Pin 11 (MOSI)
+   Pin6 (SCK) -- Pin 13 (SCK)
+   Pin7 (HOLD) -- 10K -- +5V
+   Pin8 (V+)  -- +5V
+*/
+
+#include <SRAMcheck.h>
+
+#define CSPIN 10       // Default Chip Select Line for Uno (change as needed)
+#define TABLE 0        // chip address of the calibration table
+#define POINTS 32      // entries in the table
+
+SRAMsimple sram(CSPIN);             // initialize an instance of this class on chip select CSPIN
+SRAMcheck<> check(sram);            // CRC-16 after each block
+
+float table[POINTS];
+
+void setup()
+{
+  Serial.begin(9600);                         // set communication speed for the serial monitor
+  SPI.begin();                                // start communicating with the memory chip
+
+/************ Store the table, and its CRC **********/
+  for(int i=0; i<POINTS; i++) table[i]=1.0+i*0.01;
+  check.WriteArray(TABLE, table, POINTS);
+  Serial.print("Table takes ");
+  Serial.print(SRAMcheck<>::Bytes<float>(POINTS));
+  Serial.println(" bytes on the chip");
+
+/************ Read it back: the CRC is checked on the way **********/
+  if(check.ReadArray(TABLE, table, POINTS)) Serial.println("Table read back OK");
+  else Serial.println("Table is damaged!");
+
+/************ Damage one byte, the way a brown-out might **********/
+  sram.WriteByte(TABLE+10, sram.ReadByte(TABLE+10)^0x04);
+  if(check.ReadArray(TABLE, table, POINTS)) Serial.println("Table read back OK");
+  else Serial.println("Table is damaged! Reload it from EEPROM or recalibrate.");
+  Serial.print("Failed reads: ");
+  Serial.println(check.Errors());
+}
+
+void loop()
+{
+}
@@ -0,0 +1,82 @@
+/* Example program for use with SRAMpack.h - sensor samples packed 3-4x smaller
+    Arduino Uno Memory Expansion Sample Program
+    Library created and expanded by: D. Dubins 12-Nov-18
+
+   A slowly drifting, slightly noisy signal (like analogRead() on a sensor) is stored in
+   blocks of 256 samples. Each block is packed on the way to the chip: the first value, then
+   the differences between neighbours, 8 at a time in as few bits as they need. Then a few
+   samples are read back from the middle of the log, and the whole log is checked.
+
+   Used the following components:
+   (1) Arduino Uno
+   (2) Microchip 23LC1024 SPI SRAM chip
+
+   Wiring:
+   23LC1024 - Uno:
+   ---------------
+   Pin1 (JSC) -- Pin 10 (CS) (with 10K pullup to +5V)
+   Pin2 (SO)  -- Pin 12 (MISO)
+   Pin3 (NU)  -- 10K -- +5V
+   Pin4 (GND) -- GND
+   Pin5 (SI)  -- Pin 11 (MOSI)
+   Pin6 (SCK) -- Pin 13 (SCK)
+   Pin7 (HOLD) -- 10K -- +5V
+   Pin8 (V+)  -- +5V
+*/
+
+#include <SRAMpack.h>
+
+#define CSPIN 10       // Default Chip Select Line for Uno (change as needed)
+#define BLOCK 256      // samples per block
+#define BLOCKS 32      // blocks in the log
+
+SRAMsimple sram(CSPIN);                     // initialize an instance of this class on chip select CSPIN
+SRAMpack<BLOCKS> pack(sram, 0, SRAMsize);   // a log of up to 32 packed blocks, anywhere on the chip
+
+int samples[BLOCK];
+
+/*  Sample number n of the signal (the same n always gives the same value) **********/
+int reading(long n){
+  randomSeed(n);
+  return 512+(int)(300.0*sin(n/500.0))+random(-3, 4);
+}
+
+void setup()
+{
+  Serial.begin(9600);                         // set communication speed for the serial monitor
+  SPI.begin();                                // start communicating with the memory chip
+
+/************ Record BLOCKS blocks of samples **********/
+  for(int b=0; b<BLOCKS; b++){
+    for(int i=0; i<BLOCK; i++) samples[i]=reading((long)b*BLOCK+i);
+    if(!pack.Append(samples, BLOCK)) Serial.println("Log full");
+  }
+  Serial.print("Samples stored: ");
+  Serial.println(pack.Samples());
+  Serial.print("Bytes used packed: ");
+  Serial.println(pack.Used());
+  Serial.print("Bytes WriteIntArray would use: ");
+  Serial.println(pack.Samples()*sizeof(int));
+
+/************ Random access: only the block holding sample 5000 is unpacked **********/
+  int some[5];
+  pack.Read(5000, some, 5);
+  Serial.println("Samples 5000 to 5004: ");
+  for(int i=0; i<5; i++){
+    Serial.print(some[i]);
+    Serial.print(i<4 ? ", " : "\n");
+  }
+
+/************ Check everything **********/
+  long errors=0;
+  for(long n=0; n<(long)pack.Samples(); n+=BLOCK){
+    pack.Read(n, samples, BLOCK);
+    for(int i=0; i<BLOCK; i++) if(samples[i]!=reading(n+i)) errors++;
+  }
+  Serial.print("Errors: ");
+  Serial.println(errors);
+}
+
+void loop()
+{
+}
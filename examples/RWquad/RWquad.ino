@@ -0,0 +1,92 @@
+/* Example program for use with SRAMquad.h - SQI (quad) and SDI (dual) transfers
+    Arduino Uno Memory Expansion Sample Program
+    Library created and expanded by: D. Dubins 12-Nov-18
+
+   The 23LC1024 can move 4 bits per clock (SQI) or 2 (SDI) instead of 1. SRAMquad drives the
+   chip's pins directly, so it is wired to A0-A4 here instead of the SPI pins. On an Uno,
+   A0-A3 are bits 0-3 of port C, so each nibble takes one port write.
+   Writes 1 kB, then times reading it back 1, 2 and 4 bits at a time, and times the same read
+   from a second chip on the hardware SPI pins: that is the number to beat. Quad needs a quarter
+   of the clocks, but every clock is software. Through digitalWrite()/digitalRead() a clock
+   takes microseconds, so the hardware SPI wins easily; only the one-port path can get close.
+   On the emulator every pin call is charged as a digitalWrite() on an Uno; run it with
+   chips on pins 10 and 9.
+
+   Used the following components:
+   (1) Arduino Uno
+   (2) Microchip 23LC1024 SPI SRAM chips (2)
+
+   Wiring:
+   23LC1024 - Uno:
+   ---------------
+   Pin1 (JSC)      -- Pin 10 (CS) (with 10K pullup to +5V)
+   Pin2 (SO/SIO1)  -- A1
+   Pin3 (SIO2)     -- A2
+   Pin4 (GND)      -- GND
+   Pin5 (SI/SIO0)  -- A0
+   Pin6 (SCK)      -- A4
+   Pin7 (HOLD/SIO3) -- A3 (with 10K pullup to +5V)
+   Pin8 (V+)       -- +5V
+   Second 23LC1024 (hardware SPI, for comparison) - Uno:
+   ---------------
+   Pin1 (CS) -- Pin 9, Pin2 (SO) -- Pin 12, Pin5 (SI) -- Pin 11, Pin6 (SCK) -- Pin 13,
+   Pin3 and Pin7 (HOLD) -- +5V, Pin4 -- GND, Pin8 -- +5V
+*/
+
+#include <SRAMquad.h>
+#ifdef SRAM_HOST
+#include "SRAM23LC1024.h"      // emulator, when built on Linux
+#endif
+
+#define CSPIN 10       // Default Chip Select Line for Uno (change as needed)
+#define SPICS 9        // Chip Select of the chip on the hardware SPI pins
+#define BLOCK 1024     // bytes per transfer
+
+SRAMsimple sram(CSPIN);                         // initialize an instance of this class on chip select CSPIN
+SRAMsimple hw(SPICS);                           // the chip on the hardware SPI
+SRAMquad spi(A4, A0, A1, A2, A3, 1);            // same pins, 1 bit per clock (SPI)
+SRAMquad dual(A4, A0, A1, A2, A3, 2);           // 2 bits per clock (SDI)
+SRAMquad quad(A4, A0, A1, A2, A3);              // 4 bits per clock (SQI)
+
+byte data[BLOCK];
+
+void timeRead(const char *name, SRAMsimple &chip){
+  memset(data, 0, BLOCK);
+  unsigned long t = micros();
+  chip.ReadByteArray(0, data, BLOCK);
+  t = micros()-t;
+  int bad = 0;
+  for(int i=0; i<BLOCK; i++){
+    if(data[i]!=(byte)(i*7)) bad++;
+  }
+  Serial.print(name);
+  Serial.print(": ");
+  Serial.print(t);
+  Serial.print(" us, bytes that differ: ");
+  Serial.println(bad);
+}
+
+void setup()
+{
+  Serial.begin(9600);                           // set communication speed for the serial monitor
+#ifdef SRAM_HOST
+  SRAMemu::Wire(A4, A0, A1, A2, A3);            // connect the emulated chip to the same pins
+#endif
+  for(int i=0; i<BLOCK; i++) data[i]=(byte)(i*7);
+  sram.SetBus(&quad);
+  sram.WriteByteArray(0, data, BLOCK);          // write in quad mode
+  hw.WriteByteArray(0, data, BLOCK);            // and over the hardware SPI
+
+  Serial.println("Reading 1 kB:");
+  timeRead("Hardware SPI", hw);
+  sram.SetBus(&spi);                            // RSTIO, then EDIO or EQIO as needed
+  timeRead("SPI, 1 bit per clock", sram);
+  sram.SetBus(&dual);
+  timeRead("SDI, 2 bits per clock", sram);
+  sram.SetBus(&quad);
+  timeRead("SQI, 4 bits per clock", sram);
+}
+
+void loop()
+{
+}
@@ -0,0 +1,71 @@
+/* Example program for use with SRAMring.h - a sample FIFO on the chip
+    Arduino Uno Memory Expansion Sample Program
+    Library created and expanded by: D. Dubins 12-Nov-18
+
+   Takes an analogRead() sample every millisecond and pushes it into a ring buffer on the
+   23LC1024, then every 100 samples pops everything waiting and prints the average. Push() never
+   touches SPI, so it can also be called from an interrupt (a timer or ADC ISR); the samples
+   go to the chip 16 at a time, in one sequential write each.
+   Overflows() counts samples that were dropped, HighWater() the most that were ever waiting:
+   use them to size the ring.
+
+   Used the following components:
+   (1) Arduino Uno
+   (2) Microchip 23LC1024 SPI SRAM chip
+
+   Wiring:
+   23LC1024 - Uno:
+   ---------------
+   Pin1 (JSC) -- Pin 10 (CS) (with 10K pullup to +5V)
+   Pin2 (SO)  -- Pin 12 (MISO)
+   Pin3 (NU)  -- 10K -- +5V
+   Pin4 (GND) -- GND
+   Pin5 (SI)  -- Pin 11 (MOSI)
+   Pin6 (SCK) -- Pin 13 (SCK)
+   Pin7 (HOLD) -- 10K -- +5V
+   Pin8 (V+)  -- +5V
+*/
+
+#include <SRAMring.h>
+
+#define CSPIN 10       // Default Chip Select Line for Uno (change as needed)
+
+SRAMsimple sram(CSPIN);             // initialize an instance of this class on chip select CSPIN
+SRAMring<int, 16> ring(sram);       // the whole chip holds 65536 ints; 2 staging blocks of 16 in RAM
+
+int block[32];                      // space to pop into
+unsigned int samples = 0;
+byte reports = 0;
+
+void setup()
+{
+  Serial.begin(9600);                         // set communication speed for the serial monitor
+  SPI.begin();                                // start communicating with the memory chip
+}
+
+void loop()
+{
+  ring.Push(analogRead(A0));                  // in a real logger, this goes in the timer ISR
+  ring.Service();                             // main loop: move full staging blocks to the chip
+  delay(1);
+  samples++;
+  if(samples%100 == 0 && reports < 10){       // every 100 ms: drain the ring
+    reports++;
+    long sum = 0;
+    unsigned long count = 0;
+    uint32_t n;
+    ring.Flush();                             // include the partly filled staging block
+    while((n = ring.Pop(block, 32)) > 0){     // up to 32 samples per burst
+      for(uint32_t i=0; i<n; i++) sum += block[i];
+      count += n;
+    }
+    Serial.print("Samples: ");
+    Serial.print(count);
+    Serial.print("  average: ");
+    Serial.print(count ? sum/(long)count : 0);
+    Serial.print("  high water: ");
+    Serial.print(ring.HighWater());
+    Serial.print("  overflows: ");
+    Serial.println(ring.Overflows());
+  }
+}
@@ -27,7 +27,7 @@
 #include <SRAMsimple.h>
 
 #define CSPIN 10       // Default Chip Select Line for Uno (change as needed)
-SRAMsimple sram;       //initialize an instance of this class
+SRAMsimple sram(CSPIN); //initialize an instance of this class on chip select CSPIN
 
 /*******  Set up code to define variables and start the SCI and SPI serial interfaces  *****/
 void setup()
@@ -0,0 +1,57 @@
+/* Example program for use with SRAMsimple.h - where the bus time goes
+    Arduino Uno Memory Expansion Sample Program
+    Library created and expanded by: D. Dubins 12-Nov-18
+
+   Counts what each kind of call costs: commands, data bytes, overhead bytes (command, address
+   and mode register), CS toggles and microseconds. The counters are only compiled in when
+   SRAMSIMPLE_STATS is defined: uncomment it near the top of SRAMsimple.h (or add
+   -DSRAMSIMPLE_STATS to the build flags), then upload this sketch again. Left off, they cost
+   nothing, and this sketch only prints a reminder.
+
+   Used the following components:
+   (1) Arduino Uno
+   (2) Microchip 23LC1024 SPI SRAM chip
+
+   Wiring:
+   23LC1024 - Uno:
+   ---------------
+   Pin1 (JSC) -- Pin 10 (CS) (with 10K pullup to +5V)
+   Pin2 (SO)  -- Pin 12 (MISO)
+   Pin3 (NU)  -- 10K -- +5V
+   Pin4 (GND) -- GND
+   Pin5 (SI)  -- Pin 11 (MOSI)
+   Pin6 (SCK) -- Pin 13 (SCK)
+   Pin7 (HOLD) -- 10K -- +5V
+   Pin8 (V+)  -- +5V
+*/
+
+#include <SRAMsimple.h>
+
+#define CSPIN 10               // Default Chip Select Line for Uno (change as needed)
+SRAMsimple sram(CSPIN);        // initialize an instance of this class on chip select CSPIN
+
+void setup() {
+  Serial.begin(9600);
+  SPI.begin();
+  sram.ResetStats();
+
+  for(int i=0; i<100; i++) sram.WriteByte(i, i);          // one command per byte
+  for(int i=0; i<100; i++) sram.ReadByte(i);
+  float data[25];
+  for(int i=0; i<25; i++) data[i]=i*0.5;
+  sram.WriteFloatArray(1000, data, 25);                  // one command for 100 bytes
+  sram.ReadFloatArray(1000, data, 25);
+  sram.BeginRead(0);                                     // your own streaming
+  long sum=0;
+  for(int i=0; i<100; i++) sum+=sram.Receive();
+  sram.End();
+
+  sram.PrintStats(Serial);
+  SRAMstats total=sram.Stats();
+  Serial.print("Share of bus bytes that are not data: ");
+  Serial.print(100.0*total.overhead/(total.overhead+total.payload+0.001));
+  Serial.println("%");
+}
+
+void loop() {
+}
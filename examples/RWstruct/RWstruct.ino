@@ -1,6 +1,6 @@
 /* Example program for use with SRAMsimple.h - sending structures to 23LC1024
     Arduino Uno Memory Expansion Sample Program
-    Author: This headache belonged to David Dubins 12-Dec-18
+    Author: This headache belonged to David Dubins 12-Dec-18 (no more unions: Write and Read take any type)
     Library created and expanded by: D. Dubins 12-Nov-18
    Sample program to use a Serial SRAM chip to expand memory for an Arduino Uno
    giving access to an additional 128kB of random access memory.  The 23LC1024 uses
@@ -27,7 +27,7 @@
 
 #define CSPIN 10       // Default Chip Select Line for Uno (change as needed)
 
-SRAMsimple sram;       // initialize an instance of this class
+SRAMsimple sram(CSPIN); // initialize an instance of this class on chip select CSPIN
 
 void setup()
 {
@@ -41,48 +41,43 @@ void setup()
     float MW;
   }; //declare organicA to send data and organicB to receive data
 
-  union txUnion{
-    chemElements organicA[4]; // object organicA as an array of chemElements
-    byte byteArrA[sizeof(organicA)]; // byte array sharing the same space
-  };
-  union txUnion txData; // create a new union instance called txData
-  
+  chemElements organicA[4]; // object organicA as an array of chemElements
+  chemElements organicB[4]; // object organicB to receive the data
+
   // Fill objects with data
-  strcpy(txData.organicA[0].atomName,"Hydrogen");
-  txData.organicA[0].atomNum=1;
-  txData.organicA[0].MW=1.000794;
+  strcpy(organicA[0].atomName,"Hydrogen");
+  organicA[0].atomNum=1;
+  organicA[0].MW=1.000794;
 
-  strcpy(txData.organicA[1].atomName,"Carbon");
-  txData.organicA[1].atomNum=6;
-  txData.organicA[1].MW=12.0107;
+  strcpy(organicA[1].atomName,"Carbon");
+  organicA[1].atomNum=6;
+  organicA[1].MW=12.0107;
 
-  strcpy(txData.organicA[2].atomName,"Nitrogen");
-  txData.organicA[2].atomNum=7;
-  txData.organicA[2].MW=14.0067;
+  strcpy(organicA[2].atomName,"Nitrogen");
+  organicA[2].atomNum=7;
+  organicA[2].MW=14.0067;
 
-  strcpy(txData.organicA[3].atomName,"Oxygen");
-  txData.organicA[3].atomNum=8;
-  txData.organicA[3].MW=15.9994;
+  strcpy(organicA[3].atomName,"Oxygen");
+  organicA[3].atomNum=8;
+  organicA[3].MW=15.9994;
   
-/************  Write a Sequence of Bytes from an Array *******************/
-  Serial.println("\nWriting byte array using Sequential:");
-  sram.WriteByteArray(0, txData.byteArrA, sizeof(txData.byteArrA));        // Write array to memory starting at address 0
+/************  Write the array of structures *******************/
+  Serial.println("\nWriting structure array using Sequential:");
+  sram.Write(0, organicA);               // Write works with any type: no union needed
 
-/************ Read a Sequence of Bytes from Memory into an Array **********/
-  union rxUnion{  // create a union for receiving data and reading as chemElements structure
-    chemElements organicB[4];  // object organicB as an array of chemElements
-    byte byteArrB[sizeof(organicB)]; // byte array sharing the same space
-  };
-  union rxUnion rxData; // create a new union instance called rxData
-   
-  Serial.println("Reading byte array using sequential: ");
-  sram.ReadByteArray(0, rxData.byteArrB, sizeof(rxData.byteArrB));   // Read array into byteArrB starting at address 0
+/************ Read the array of structures back **********/
+  Serial.println("Reading structure array using sequential: ");
+  sram.Read(0, organicB);                // Read into organicB starting at address 0
 
   for(int i=0;i<4;i++){
-    Serial.println(rxData.organicB[i].atomName); // print received char array
-    Serial.println(rxData.organicB[i].atomNum); // print received int
-    Serial.println(rxData.organicB[i].MW,4); // print received float
+    Serial.println(organicB[i].atomName); // print received char array
+    Serial.println(organicB[i].atomNum); // print received int
+    Serial.println(organicB[i].MW,4); // print received float
   }
+
+/************ One structure at a time works too **********/
+  chemElements oneElement=sram.Read<chemElements>(sizeof(chemElements)*2);  // third element (Nitrogen)
+  Serial.println(oneElement.atomName);
 }
 
 void loop()
@@ -0,0 +1,124 @@
+/* Example program for use with SRAMsimple.h - how fast is the SPI bus?
+    Arduino Uno Memory Expansion Sample Program
+    Library created and expanded by: D. Dubins 12-Nov-18
+
+   First times single-byte reads done the way the library used to do them: a WRMR command
+   before every access, and CS toggled with digitalWrite(). Then times the same transfers
+   with the library twice: at 4 MHz (the Arduino SPI default, which is what the chip ran at
+   before the library set its own clock), where the only difference from the old way is the
+   cached mode register and the direct port CS, then at the default clock of the library
+   (20 MHz, the fastest the 23LC1024 can go; an Uno at 16 MHz tops out at 8 MHz).
+   Prints bytes per second for each test.
+   On the host emulator (extras/host) only bus time is counted, so digitalWrite() costs nothing
+   there and the old/new difference comes from the WRMR commands alone.
+
+   Used the following components:
+   (1) Arduino Uno
+   (2) Microchip 23LC1024 SPI SRAM chip
+
+   Wiring:
+   23LC1024 - Uno:
+   ---------------
+   Pin1 (JSC) -- Pin 10 (CS) (with 10K pullup to +5V)
+   Pin2 (SO)  -- Pin 12 (MISO)
+   Pin3 (NU)  -- 10K -- +5V
+   Pin4 (GND) -- GND
+   Pin5 (SI)  -- Pin 11 (MOSI)
+   Pin6 (SCK) -- Pin 13 (SCK)
+   Pin7 (HOLD) -- 10K -- +5V
+   Pin8 (V+)  -- +5V
+*/
+
+#include <SRAMsimple.h>
+
+#define CSPIN 10       // Default Chip Select Line for Uno (change as needed)
+#define BLOCK 256      // bytes per array transfer
+#define REPEATS 20     // number of times each test is run
+
+SRAMsimple sram(CSPIN); // initialize an instance of this class on chip select CSPIN
+
+byte buf[BLOCK];       // data to write and space to read
+
+void report(const char *name, unsigned long bytes, unsigned long us){
+  Serial.print(name);
+  Serial.print(": ");
+  Serial.print(us);
+  Serial.print(" us, ");
+  Serial.print(us ? (bytes*1000000.0/us) : 0.0, 0);   // bytes per second
+  Serial.println(" bytes/s");
+}
+
+/*  ReadByte as the library did it before: WRMR on every call, CS with digitalWrite() **********/
+byte oldReadByte(uint32_t address){
+  digitalWrite(CSPIN, LOW);
+  SPI.transfer(WRMR);
+  SPI.transfer(ByteMode);
+  digitalWrite(CSPIN, HIGH);
+  digitalWrite(CSPIN, LOW);
+  SPI.transfer(READ);
+  SPI.transfer((byte)(address >> 16));
+  SPI.transfer((byte)(address >> 8));
+  SPI.transfer((byte)address);
+  byte data = SPI.transfer(0x00);
+  digitalWrite(CSPIN, HIGH);
+  return data;
+}
+
+void runTests(){
+  unsigned long t;
+  t=micros();
+  for(int r=0; r<REPEATS; r++) sram.WriteByteArray(0, buf, BLOCK);
+  report("WriteByteArray", (unsigned long)BLOCK*REPEATS, micros()-t);
+
+  t=micros();
+  for(int r=0; r<REPEATS; r++) sram.ReadByteArray(0, buf, BLOCK);
+  report("ReadByteArray ", (unsigned long)BLOCK*REPEATS, micros()-t);
+
+  t=micros();
+  for(int r=0; r<REPEATS; r++){
+    for(int i=0; i<BLOCK; i+=2) sram.ReadInt(i);        // many small reads
+  }
+  report("ReadInt       ", (unsigned long)BLOCK*REPEATS, micros()-t);
+
+  t=micros();
+  for(int r=0; r<REPEATS; r++){
+    for(int i=0; i<BLOCK; i++) sram.WriteByte(i, (byte)i);
+  }
+  report("WriteByte     ", (unsigned long)BLOCK*REPEATS, micros()-t);
+
+  t=micros();
+  for(int r=0; r<REPEATS; r++){
+    for(int i=0; i<BLOCK; i++) sram.ReadByte(i);
+  }
+  report("ReadByte      ", (unsigned long)BLOCK*REPEATS, micros()-t);
+}
+
+void setup()
+{
+  Serial.begin(9600);                         // set communication speed for the serial monitor
+  SPI.begin();                                // start communicating with the memory chip
+  for(int i=0; i<BLOCK; i++) buf[i]=(byte)i;  // some data to send
+
+  pinMode(CSPIN, OUTPUT);
+  digitalWrite(CSPIN, HIGH);
+  Serial.println("\nBefore: ReadByte with WRMR every call and digitalWrite() CS, 4 MHz:");
+  SPI.beginTransaction(SPISettings(4000000, MSBFIRST, SPI_MODE0));  // the old code never set the clock: 4 MHz default
+  unsigned long t=micros();
+  for(int r=0; r<REPEATS; r++){
+    for(int i=0; i<BLOCK; i++) oldReadByte(i);
+  }
+  report("ReadByte (old)", (unsigned long)BLOCK*REPEATS, micros()-t);
+  SPI.endTransaction();
+
+  Serial.println("\nSPI clock 4 MHz (Arduino default):");
+  sram.SetClock(4000000);
+  runTests();
+
+  Serial.println("\nSPI clock 20 MHz (library default, board maximum):");
+  sram.SetClock(SRAMmaxClock);
+  runTests();
+}
+
+void loop()
+{
+}
@@ -0,0 +1,96 @@
+/*  Arduino.h - host (Linux) stand-in for the Arduino core, so SRAMsimple and the example
+ *  sketches compile with g++ against the 23LC1024 emulator in SRAM23LC1024.h.
+ *  Only what the library and its examples use is provided.
+ *  Released into the public domain.
+ */
+
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+
+#define SRAM_HOST   1       // sketches can check for this to use the emulator's counters
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH      1
+#define LOW       0
+#define INPUT     0
+#define OUTPUT    1
+#define INPUT_PULLUP 2
+#define LSBFIRST  0
+#define MSBFIRST  1
+#define DEC       10
+#define HEX       16
+#define A0        14
+#define A1        15
+#define A2        16
+#define A3        17
+#define A4        18
+#define A5        19
+
+#define PROGMEM
+#define F(s)                (s)
+#define pgm_read_byte(p)    (*(const uint8_t *)(p))
+#define pgm_read_word(p)    (*(const uint16_t *)(p))
+#define pgm_read_dword(p)   (*(const uint32_t *)(p))
+#define noInterrupts()
+#define interrupts()
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+unsigned long micros();
+unsigned long millis();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+class Print {
+  public:
+    virtual ~Print(){}
+    virtual size_t write(uint8_t c)=0;
+    size_t write(const uint8_t *buf, size_t n){ size_t r=0; while(n--) r+=write(*buf++); return r; }
+    size_t print(const char *s){ return write((const uint8_t *)s, strlen(s)); }
+    size_t print(char c){ return write((uint8_t)c); }
+    size_t print(unsigned char v, int base=DEC){ return print((unsigned long)v, base); }
+    size_t print(int v, int base=DEC){ return print((long)v, base); }
+    size_t print(unsigned int v, int base=DEC){ return print((unsigned long)v, base); }
+    size_t print(long v, int base=DEC){ char b[24]; snprintf(b, sizeof(b), base==HEX?"%lX":"%ld", v); return print(b); }
+    size_t print(unsigned long v, int base=DEC){ char b[24]; snprintf(b, sizeof(b), base==HEX?"%lX":"%lu", v); return print(b); }
+    size_t print(double v, int digits=2){ char b[48]; snprintf(b, sizeof(b), "%.*f", digits, v); return print(b); }
+    size_t println(){ return print("\r\n"); }
+    template<class T> size_t println(T v){ size_t n=print(v); return n+println(); }
+    template<class T> size_t println(T v, int fmt){ size_t n=print(v, fmt); return n+println(); }
+};
+
+class Stream : public Print {
+  public:
+    virtual int available()=0;
+    virtual int read()=0;
+    virtual int peek()=0;
+    void setTimeout(unsigned long ms){ (void)ms; }
+    size_t readBytes(uint8_t *buf, size_t n){ size_t i=0; int c; while(i<n && (c=read())>=0) buf[i++]=(uint8_t)c; return i; }
+};
+
+class HardwareSerial : public Stream {
+  public:
+    void begin(unsigned long baud){ (void)baud; }
+    virtual size_t write(uint8_t c);
+    virtual int available();
+    virtual int read();
+    virtual int peek();
+    operator bool(){ return true; }
+};
+extern HardwareSerial Serial;
+
+#endif
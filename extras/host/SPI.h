@@ -0,0 +1,38 @@
+/*  SPI.h - host (Linux) stand-in for the Arduino SPI library. Bytes are clocked into
+ *  whichever 23LC1024 emulator (SRAM23LC1024.h) has its chip select LOW.
+ *  Released into the public domain.
+ */
+
+#ifndef SPI_h
+#define SPI_h
+
+#include <Arduino.h>
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x04
+#define SPI_MODE2 0x08
+#define SPI_MODE3 0x0C
+
+class SPISettings {
+  public:
+    SPISettings(uint32_t clock=4000000, uint8_t bitOrder=MSBFIRST, uint8_t dataMode=SPI_MODE0)
+      : clock(clock), bitOrder(bitOrder), dataMode(dataMode) {}
+    uint32_t clock;
+    uint8_t bitOrder;
+    uint8_t dataMode;
+};
+
+class SPIClass {
+  public:
+    void begin(){}
+    void end(){}
+    void beginTransaction(SPISettings settings);
+    void endTransaction();
+    uint8_t transfer(uint8_t data);
+    uint16_t transfer16(uint16_t data){ uint16_t h=transfer(data>>8); return (h<<8)|transfer(data&0xFF); }
+    void transfer(void *buf, size_t count){ uint8_t *p=(uint8_t *)buf; while(count--){ *p=transfer(*p); p++; } }
+    void usingInterrupt(uint8_t n){ (void)n; }
+};
+extern SPIClass SPI;
+
+#endif
@@ -0,0 +1,297 @@
+/*  SRAM23LC1024.cpp - host (Linux) model of the Microchip 23LC1024 SPI SRAM.
+ *  Released into the public domain.
+ */
+
+#include "SRAM23LC1024.h"
+
+#define ST_IDLE     0           // CS high
+#define ST_CMD      1           // waiting for the instruction byte
+#define ST_ADDR     2           // clocking in the 24-bit address
+#define ST_DATA     3           // READ/WRITE data phase
+#define ST_WRMR     4           // waiting for the new mode register value
+#define ST_RDMR     5           // shifting out the mode register
+#define ST_IGNORE   6           // rest of the command is ignored until CS goes high
+#define ST_DUMMY    7           // SDI/SQI READ: one dummy byte after the address
+
+#define OP_READ     0x03
+#define OP_WRITE    0x02
+#define OP_RDMR     0x05
+#define OP_WRMR     0x01
+#define OP_EDIO     0x3B
+#define OP_EQIO     0x38
+#define OP_RSTIO    0xFF
+
+SRAM23LC1024::SRAM23LC1024(uint8_t pin){
+  csPin=pin;
+  memset(mem, 0, sizeof(mem));
+  commands=reads=writes=modeWrites=csToggles=errors=0;
+  _selected=false;
+  _bits=0;
+  PowerOn();
+}
+
+void SRAM23LC1024::PowerOn(){
+  mode=EMU_SEQ;                                   // 23LC1024 powers up in Sequential mode
+  io=EMU_SPI;
+  _state=ST_IDLE;
+}
+
+void SRAM23LC1024::Select(bool selected){
+  if(selected==_selected) return;
+  _selected=selected;
+  if(selected){
+    _state=ST_CMD;                                // CS low: next byte is an instruction
+  }else{
+    _state=ST_IDLE;                               // CS high ends any command
+    _bits=0;
+    csToggles++;
+  }
+}
+
+/*  Data phase: read the current byte, store the incoming one, then move the address */
+uint8_t SRAM23LC1024::Data(uint8_t out){
+  if(mode==EMU_BYTE && !_firstData) return 0xFF; // Byte mode: one byte per command only
+  _firstData=false;
+  uint8_t in=0xFF;
+  if(_cmd==OP_READ){
+    in=mem[_addr];
+    reads++;
+  }else{
+    mem[_addr]=out;
+    writes++;
+  }
+  if(mode==EMU_PAGEMODE){
+    _addr=(_addr&~(uint32_t)(EMU_PAGE-1))|((_addr+1)&(EMU_PAGE-1));  // wrap inside the page
+  }else{
+    _addr=(_addr+1)&(EMU_SIZE-1);                 // wrap at the end of the array
+  }
+  return in;
+}
+
+uint8_t SRAM23LC1024::Clock(uint8_t out){
+  if(!_selected) return 0xFF;                     // SO is high impedance
+  if(io!=EMU_SPI && !(_state==ST_CMD && out==OP_RSTIO)){
+    errors++;                                     // chip is in SDI/SQI mode: single-SPI bytes make no sense
+    return 0xFF;
+  }
+  return Byte(out);
+}
+
+/*  Pin level: latch io bits (SI only in SPI mode) on this rising edge. A byte the chip sends is
+ *  fetched on its first clock and shifted out a few bits per clock, valid while SCK is high */
+int SRAM23LC1024::Edge(uint8_t sio){
+  if(!_selected) return -1;
+  uint8_t w=io;                                   // bits per clock: 1, 2 or 4
+  if(_bits==0){
+    _driving=(_state==ST_DATA && _cmd==OP_READ) || _state==ST_RDMR;
+    if(_driving) _shiftOut=Byte(0xFF);
+    _shiftIn=0;
+  }
+  _shiftIn=(uint8_t)((_shiftIn<<w)|(sio&((1<<w)-1)));
+  _bits+=w;
+  int bits=-1;
+  if(_driving){
+    bits=(_shiftOut>>(8-_bits))&((1<<w)-1);
+    if(w==EMU_SPI) bits<<=1;                      // SPI mode: the answer comes out on SO (SIO1)
+  }
+  if(_bits>=8){
+    if(!_driving) Byte(_shiftIn);
+    _bits=0;
+  }
+  return bits;
+}
+
+uint8_t SRAM23LC1024::Byte(uint8_t out){
+  switch(_state){
+    case ST_CMD:
+      _cmd=out;
+      commands++;
+      _count=0;
+      _addr=0;
+      switch(out){
+        case OP_READ:
+        case OP_WRITE: _state=ST_ADDR; break;
+        case OP_WRMR: _state=ST_WRMR; break;
+        case OP_RDMR: _state=ST_RDMR; break;
+        case OP_EDIO: io=EMU_SDI; _state=ST_IGNORE; break;
+        case OP_EQIO: io=EMU_SQI; _state=ST_IGNORE; break;
+        case OP_RSTIO: io=EMU_SPI; _state=ST_IGNORE; break;
+        default: errors++; _state=ST_IGNORE; break;
+      }
+      return 0xFF;
+    case ST_ADDR:
+      _addr=(_addr<<8)|out;
+      if(++_count==3){
+        _addr&=EMU_SIZE-1;                        // upper 7 address bits are don't-care
+        _firstData=true;
+        _state=(_cmd==OP_READ && io!=EMU_SPI) ? ST_DUMMY : ST_DATA;
+      }
+      return 0xFF;
+    case ST_DUMMY:
+      _state=ST_DATA;
+      return 0xFF;
+    case ST_DATA:
+      return Data(out);
+    case ST_WRMR:
+      mode=out&0xC0;                              // only bits 7:6 are implemented
+      modeWrites++;
+      _state=ST_IGNORE;
+      return 0xFF;
+    case ST_RDMR:
+      return mode;                                // keeps returning the mode register
+    default:
+      return 0xFF;
+  }
+}
+
+/************ The bus ***************************/
+#define EMU_MAX_CHIPS 16
+
+static SRAM23LC1024 *chips[EMU_MAX_CHIPS];
+static uint8_t nchips=0;
+static uint32_t spiClock=4000000;                 // Arduino default: 16 MHz / 4
+static double busNanos=0;
+static unsigned long spiBytes=0;
+static unsigned long sckClocks=0;
+static uint8_t sckPin=0xFF;                       // bit-banged bus pins (0xFF: not wired)
+static uint8_t sioPin[4]={0xFF, 0xFF, 0xFF, 0xFF};
+static uint8_t pinLevel[256];                     // last level written to each pin by the sketch
+static uint8_t pinOutput[256];                    // pin is an output on the board
+static int8_t pinDriven[256];                     // level a chip drives onto the pin, or -1
+static bool pinsReady=false;
+
+static void PinsInit(){
+  if(pinsReady) return;
+  memset(pinLevel, HIGH, sizeof(pinLevel));       // pull-ups
+  memset(pinOutput, 0, sizeof(pinOutput));
+  memset(pinDriven, -1, sizeof(pinDriven));
+  pinsReady=true;
+}
+
+namespace SRAMemu {
+
+SRAM23LC1024 *Attach(uint8_t csPin){
+  SRAM23LC1024 *c=Chip(csPin);
+  if(c) return c;
+  if(nchips>=EMU_MAX_CHIPS) return 0;
+  c=new SRAM23LC1024(csPin);
+  chips[nchips++]=c;
+  return c;
+}
+
+SRAM23LC1024 *Chip(uint8_t csPin){
+  for(uint8_t i=0; i<nchips; i++){
+    if(chips[i]->csPin==csPin) return chips[i];
+  }
+  return 0;
+}
+
+void ResetCounters(){
+  busNanos=0;
+  spiBytes=0;
+  sckClocks=0;
+  for(uint8_t i=0; i<nchips; i++){
+    SRAM23LC1024 *c=chips[i];
+    c->commands=c->reads=c->writes=c->modeWrites=c->csToggles=c->errors=0;
+  }
+}
+
+uint32_t Clock(){ return spiClock; }
+double BusNanos(){ return busNanos; }
+unsigned long SpiBytes(){ return spiBytes; }
+unsigned long SckClocks(){ return sckClocks; }
+void AddNanos(double ns){ busNanos+=ns; }
+
+void Wire(uint8_t sck, uint8_t sio0, uint8_t sio1, uint8_t sio2, uint8_t sio3){
+  PinsInit();
+  sckPin=sck;
+  sioPin[0]=sio0;
+  sioPin[1]=sio1;
+  sioPin[2]=sio2;
+  sioPin[3]=sio3;
+}
+
+unsigned long CsToggles(){
+  unsigned long n=0;
+  for(uint8_t i=0; i<nchips; i++) n+=chips[i]->csToggles;
+  return n;
+}
+
+}
+
+/************ Hooks for the Arduino and SPI stand-ins ***************************/
+
+/*  A pin call from the sketch: on the bit-banged bus pins, charge what it takes on the board */
+static void PinCall(uint8_t pin){
+  if(pin==0xFF) return;
+  if(pin==sckPin || pin==sioPin[0] || pin==sioPin[1] || pin==sioPin[2] || pin==sioPin[3]) busNanos+=EMU_TPIN;
+}
+
+/*  Rising edge on the bit-banged SCK: every selected chip takes its bits, and may drive some back */
+static void SckEdge(){
+  sckClocks++;
+  uint8_t sio=0;
+  for(uint8_t i=0; i<4; i++){
+    if(sioPin[i]==0xFF) sio|=1<<i;                // not wired: pulled up
+    else{
+      pinDriven[sioPin[i]]=-1;                    // last clock's answer is gone
+      sio|=(pinLevel[sioPin[i]] ? 1 : 0)<<i;
+    }
+  }
+  for(uint8_t i=0; i<nchips; i++){
+    int bits=chips[i]->Edge(sio);
+    if(bits<0) continue;
+    uint8_t mask=(chips[i]->io==EMU_SPI) ? 0x02 : (uint8_t)((1<<chips[i]->io)-1);
+    for(uint8_t j=0; j<4; j++){
+      if(!(mask&(1<<j)) || sioPin[j]==0xFF) continue;
+      if(pinOutput[sioPin[j]]) chips[i]->errors++; // board and chip both driving the line
+      pinDriven[sioPin[j]]=(bits>>j)&1;
+    }
+  }
+}
+
+void EmuPinMode(uint8_t pin, uint8_t mode){
+  PinsInit();
+  PinCall(pin);
+  pinOutput[pin]=(mode==OUTPUT);
+}
+
+int EmuPinRead(uint8_t pin){
+  PinsInit();
+  PinCall(pin);
+  return pinDriven[pin];
+}
+
+void EmuPinWrite(uint8_t pin, uint8_t val){
+  PinsInit();
+  PinCall(pin);
+  if(pin==sckPin && val && !pinLevel[pin]){
+    pinLevel[pin]=val;
+    SckEdge();
+    return;
+  }
+  pinLevel[pin]=val;
+  SRAM23LC1024 *c=SRAMemu::Chip(pin);
+  if(!c) return;
+  if(!val && !c->Selected()) busNanos+=EMU_TCSS;  // CS falling edge
+  if(val && c->Selected()){                       // CS rising edge: the chip lets go of SIO
+    busNanos+=EMU_TCSH+EMU_TCSD;
+    for(uint8_t i=0; i<4; i++) if(sioPin[i]!=0xFF) pinDriven[sioPin[i]]=-1;
+  }
+  c->Select(!val);
+}
+
+void EmuSetClock(uint32_t hz){
+  spiClock=hz;
+}
+
+uint8_t EmuTransfer(uint8_t out){
+  spiBytes++;
+  sckClocks+=8;
+  busNanos+=8.0e9/spiClock;                       // 8 SCK cycles per byte
+  uint8_t in=0xFF;                                // MISO pulled up when nobody drives it
+  for(uint8_t i=0; i<nchips; i++){
+    if(chips[i]->Selected()) in&=chips[i]->Clock(out);  // two chips selected: bus contention
+  }
+  return in;
+}
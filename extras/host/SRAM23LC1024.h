@@ -0,0 +1,80 @@
+/*  SRAM23LC1024.h - host (Linux) model of the Microchip 23LC1024 SPI SRAM.
+ *  Models the mode register (Byte, Page, Sequential), the READ/WRITE/RDMR/WRMR commands,
+ *  address wrap at 128 KB (Sequential) or 32 bytes (Page), EDIO/EQIO/RSTIO, and counts
+ *  SPI bytes, CS toggles and modeled bus time at the SPI clock set by SPI.beginTransaction().
+ *  Bit-banged buses (SRAMquad) work at pin level: after SRAMemu::Wire(), each rising edge on
+ *  the SCK pin clocks 1, 2 or 4 bits through the SIO pins, depending on the chip's I/O mode.
+ *  Their time is what the board spends on the pins: EMU_TPIN for every digitalWrite(),
+ *  digitalRead() or pinMode() on the SCK or SIO pins, not the SPI clock.
+ *  Chips are attached to chip select pins; a chip on pin 10 is attached at start-up.
+ *  Released into the public domain.
+ */
+
+#ifndef SRAM23LC1024_h
+#define SRAM23LC1024_h
+
+#include <Arduino.h>
+
+#define EMU_SIZE    0x20000UL   // 128 KB array
+#define EMU_PAGE    32          // page size for Page mode
+#define EMU_BYTE    0x00        // mode register: Byte mode
+#define EMU_PAGEMODE 0x80       // mode register: Page mode
+#define EMU_SEQ     0x40        // mode register: Sequential mode (power-on default)
+#define EMU_SPI     1           // single I/O
+#define EMU_SDI     2           // dual I/O (after EDIO)
+#define EMU_SQI     4           // quad I/O (after EQIO)
+
+// Timing at 4.5-5.5 V from the 23LC1024 datasheet, in nanoseconds
+#define EMU_TCSS    25          // CS setup time
+#define EMU_TCSH    50          // CS hold time
+#define EMU_TCSD    25          // CS disable time
+
+// A digitalWrite(), digitalRead() or pinMode() call on a 16 MHz AVR, about 56 CPU clocks
+#define EMU_TPIN    3500
+
+class SRAM23LC1024 {
+  public:
+    SRAM23LC1024(uint8_t csPin);
+    void PowerOn();                     // mode register and I/O back to power-on state
+    void Select(bool selected);         // CS edge: true when CS goes LOW
+    uint8_t Clock(uint8_t out);         // clock one byte through in single-SPI mode
+    int Edge(uint8_t sio);              // SCK rising edge with SIO3..0 levels: bits driven back, or -1
+    bool Selected(){ return _selected; }
+    uint8_t csPin;
+    uint8_t mem[EMU_SIZE];              // the memory array
+    uint8_t mode;                       // mode register
+    uint8_t io;                         // EMU_SPI, EMU_SDI or EMU_SQI
+    unsigned long commands;             // READ/WRITE/RDMR/WRMR/... commands received
+    unsigned long reads, writes;        // data bytes read and written
+    unsigned long modeWrites;           // WRMR commands received
+    unsigned long csToggles;            // CS LOW->HIGH cycles
+    unsigned long errors;               // bytes clocked in a way the chip would not understand
+  private:
+    uint8_t Data(uint8_t out);          // data phase: returns the byte read
+    uint8_t Byte(uint8_t out);          // one whole byte at the current I/O width
+    bool _selected;
+    uint8_t _state;                     // where we are in the command
+    uint8_t _cmd;
+    uint8_t _count;                     // address bytes / dummy bytes seen so far
+    uint32_t _addr;
+    bool _firstData;
+    uint8_t _bits;                      // pin level: bits of the current byte clocked so far
+    uint8_t _shiftIn, _shiftOut;
+    bool _driving;                      // pin level: the chip is sending this byte
+};
+
+/*  The bus: every attached chip, the SPI clock, and the counters for the whole bus */
+namespace SRAMemu {
+  SRAM23LC1024 *Attach(uint8_t csPin);  // add a chip on this CS pin (returns the existing one if there is)
+  SRAM23LC1024 *Chip(uint8_t csPin);    // chip on this CS pin, or 0
+  void ResetCounters();                 // zero bus and chip counters
+  uint32_t Clock();                     // SPI clock in Hz from the last SPI.beginTransaction()
+  double BusNanos();                    // modeled bus time so far (ns)
+  unsigned long SpiBytes();             // bytes clocked over SPI
+  unsigned long SckClocks();            // SCK cycles, hardware SPI and bit-banged
+  unsigned long CsToggles();            // CS cycles on all chips
+  void AddNanos(double ns);             // let other bus drivers (bit-banged I/O) add time
+  void Wire(uint8_t sck, uint8_t sio0, uint8_t sio1, uint8_t sio2, uint8_t sio3);  // pins of a bit-banged bus
+}
+
+#endif
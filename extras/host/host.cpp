@@ -0,0 +1,80 @@
+/*  host.cpp - host (Linux) stand-ins for the Arduino core and SPI library, wired to the
+ *  23LC1024 emulator, plus a main() that runs a sketch: setup() once, then loop().
+ *  micros() and millis() report the modeled SPI bus time, so sketches that time
+ *  themselves report what the bus would deliver at the configured SPI clock.
+ *  Released into the public domain.
+ */
+
+#include <Arduino.h>
+#include <SPI.h>
+#include "SRAM23LC1024.h"
+
+void EmuPinWrite(uint8_t pin, uint8_t val);
+void EmuPinMode(uint8_t pin, uint8_t mode);
+int EmuPinRead(uint8_t pin);
+void EmuSetClock(uint32_t hz);
+uint8_t EmuTransfer(uint8_t out);
+
+HardwareSerial Serial;
+SPIClass SPI;
+
+static uint8_t pinLevel[256];
+
+void pinMode(uint8_t pin, uint8_t mode){
+  if(mode==INPUT_PULLUP) pinLevel[pin]=HIGH;
+  EmuPinMode(pin, mode);
+}
+
+void digitalWrite(uint8_t pin, uint8_t val){
+  pinLevel[pin]=val?HIGH:LOW;
+  EmuPinWrite(pin, pinLevel[pin]);
+}
+
+int digitalRead(uint8_t pin){
+  int driven=EmuPinRead(pin);                     // a chip sending on this line wins
+  return (driven>=0) ? driven : pinLevel[pin];
+}
+
+int analogRead(uint8_t){
+  SRAMemu::AddNanos(112000);                      // an Uno conversion takes about 112 us
+  return 512;
+}
+
+unsigned long micros(){ return (unsigned long)(SRAMemu::BusNanos()/1000.0); }
+unsigned long millis(){ return (unsigned long)(SRAMemu::BusNanos()/1000000.0); }
+void delay(unsigned long ms){ SRAMemu::AddNanos(ms*1.0e6); }
+void delayMicroseconds(unsigned int us){ SRAMemu::AddNanos(us*1.0e3); }
+long random(long howbig){ return howbig>0 ? rand()%howbig : 0; }
+long random(long howsmall, long howbig){ return howsmall+random(howbig-howsmall); }
+void randomSeed(unsigned long seed){ srand(seed); }
+
+size_t HardwareSerial::write(uint8_t c){
+  if(c!='\r') putchar(c);                         // println sends \r\n: keep host output clean
+  return 1;
+}
+int HardwareSerial::available(){ return peek()>=0; }
+int HardwareSerial::read(){ return getchar(); }
+int HardwareSerial::peek(){ int c=getchar(); if(c!=EOF) ungetc(c, stdin); return c; }
+
+void SPIClass::beginTransaction(SPISettings settings){ EmuSetClock(settings.clock); }
+void SPIClass::endTransaction(){}
+uint8_t SPIClass::transfer(uint8_t data){ return EmuTransfer(data); }
+
+void setup();
+void loop();
+
+/*  Usage: sketch [loops] [cs pins...]  -- runs loop() 'loops' times (default 1), with a
+ *  23LC1024 on each listed CS pin (default: pin 10). */
+int main(int argc, char **argv){
+  int loops=(argc>1) ? atoi(argv[1]) : 1;
+  if(argc>2){
+    for(int i=2; i<argc; i++) SRAMemu::Attach((uint8_t)atoi(argv[i]));
+  }else{
+    SRAMemu::Attach(10);
+  }
+  for(int i=0; i<256; i++) pinLevel[i]=HIGH;      // CS lines idle high (pull-ups)
+  setup();
+  for(int i=0; i<loops; i++) loop();
+  fflush(stdout);
+  return 0;
+}
@@ -0,0 +1,445 @@
+/*  HostTest.ino - regression test for the whole library, against the 23LC1024 emulator.
+ *  Writes with every API, reads back with every API, and checks the bytes that landed in the
+ *  emulated chips: the core and SRAMbank, then each add-on (cache, ring, batch, allocators,
+ *  array, check, pack, async, quad). Prints each check that fails and exits with 1 if any did
+ *  (0 if all passed), so a script or CI job can run it. Run with chips on CS pins 10 and 9:
+ *    make -C extras/host test
+ *  Released into the public domain.
+ */
+
+#include <SRAMsimple.h>
+#include <SRAMbank.h>
+#include <SRAMcache.h>
+#include <SRAMring.h>
+#include <SRAMbatch.h>
+#include <SRAMalloc.h>
+#include <SRAMarray.h>
+#include <SRAMcheck.h>
+#include <SRAMpack.h>
+#include <SRAMasync.h>
+#include <SRAMquad.h>
+#include "SRAM23LC1024.h"
+
+SRAMsimple chips[2] = {SRAMsimple(10), SRAMsimple(9)};
+SRAMsimple &sram = chips[0];
+SRAMbank bank(chips, 2);
+int failures = 0;
+
+void check(bool ok, const char *what){
+  if(ok) return;
+  failures++;
+  Serial.print("FAIL: ");
+  Serial.println(what);
+}
+
+struct Record {
+  long id;
+  float value;
+  char tag[5];
+};
+
+struct Big {                                    // over 255 bytes: too long for a byte counter
+  byte data[300];
+  int last;
+};
+
+void fillBig(Big &b, int seed){
+  for(int k=0; k<300; k++) b.data[k] = k*seed+1;
+  b.last = seed;
+}
+
+/************ Single values: written one way, read back every way that applies **********/
+void values(){
+  sram.WriteByte(0x100, 0xA5);
+  check(sram.ReadByte(0x100)==0xA5, "WriteByte/ReadByte");
+  sram.WriteInt(0x110, -12345);
+  check(sram.ReadInt(0x110)==-12345, "WriteInt/ReadInt");
+  sram.WriteUnsignedInt(0x120, 54321);
+  check(sram.ReadUnsignedInt(0x120)==54321, "WriteUnsignedInt/ReadUnsignedInt");
+  sram.WriteLong(0x130, -123456789L);
+  check(sram.ReadLong(0x130)==-123456789L, "WriteLong/ReadLong");
+  sram.WriteUnsignedLong(0x140, 3000000000UL);
+  check(sram.ReadUnsignedLong(0x140)==3000000000UL, "WriteUnsignedLong/ReadUnsignedLong");
+  sram.WriteFloat(0x150, 3.25);
+  check(sram.ReadFloat(0x150)==3.25, "WriteFloat/ReadFloat");
+  Record r = {42, 1.5, "abcd"}, back;
+  sram.Write(0x160, r);
+  sram.Read(0x160, back);
+  check(back.id==42 && back.value==1.5 && strcmp(back.tag, "abcd")==0, "Write/Read struct");
+  static Big big, bigBack;
+  fillBig(big, 5);
+  sram.Write(0x200, big);                       // would never finish with a byte counter
+  sram.Read(0x200, bigBack);
+  check(memcmp(&big, &bigBack, sizeof(Big))==0, "Write/Read struct over 255 bytes");
+  check(SRAMemu::Chip(10)->mem[0x200+299]==big.data[299], "struct over 255 bytes stored as it sits in memory");
+
+  sram.WriteInt(0x180, 0x1234);                 // integers go high byte first
+  uint8_t *mem = SRAMemu::Chip(10)->mem;
+  check(mem[0x180+sizeof(int)-2]==0x12 && mem[0x180+sizeof(int)-1]==0x34, "int stored high byte first");
+}
+
+/************ Arrays, including ones that wrap past the end of the chip **********/
+void arrays(){
+  static byte b[300], bb[300];
+  static int i[100], ii[100];
+  static long l[50], ll[50];
+  static float f[60], ff[60];
+  for(int k=0; k<300; k++) b[k] = k*7;
+  for(int k=0; k<100; k++) i[k] = k*300-15000;
+  for(int k=0; k<50; k++) l[k] = k*100000L-2500000L;
+  for(int k=0; k<60; k++) f[k] = k*0.25;
+  sram.WriteByteArray(0x1000, b, 300);
+  sram.ReadByteArray(0x1000, bb, 300);
+  check(memcmp(b, bb, sizeof(b))==0, "WriteByteArray/ReadByteArray");
+  sram.WriteIntArray(0x2000, i, 100);
+  sram.ReadIntArray(0x2000, ii, 100);
+  check(memcmp(i, ii, sizeof(i))==0, "WriteIntArray/ReadIntArray");
+  for(int k=0; k<100; k++) check(sram.ReadInt(0x2000+k*sizeof(int))==i[k], "ReadInt inside an int array");
+  sram.WriteLongArray(0x3000, l, 50);
+  sram.ReadLongArray(0x3000, ll, 50);
+  check(memcmp(l, ll, sizeof(l))==0, "WriteLongArray/ReadLongArray");
+  sram.WriteFloatArray(0x4000, f, 60);
+  sram.ReadFloatArray(0x4000, ff, 60);
+  check(memcmp(f, ff, sizeof(f))==0, "WriteFloatArray/ReadFloatArray");
+  static Big big[3], bigBack[3];
+  for(int k=0; k<3; k++) fillBig(big[k], k+2);
+  sram.WriteArray(0x5000, big, 3);
+  sram.ReadArray(0x5000, bigBack, 3);
+  check(memcmp(big, bigBack, sizeof(big))==0, "WriteArray/ReadArray of structs over 255 bytes");
+
+  sram.WriteByteArray(SRAMsize-100, b, 300);    // 100 bytes at the end, 200 from address 0
+  uint8_t *mem = SRAMemu::Chip(10)->mem;
+  check(mem[SRAMsize-1]==b[99] && mem[0]==b[100] && mem[199]==b[299], "array wraps at 0x1FFFF");
+  sram.ReadByteArray(SRAMsize-100, bb, 300);
+  check(memcmp(b, bb, sizeof(b))==0, "read wraps at 0x1FFFF");
+}
+
+/************ The mode register is only written when it has to change **********/
+void modes(){
+  SRAM23LC1024 *chip = SRAMemu::Chip(10);
+  sram.ReadByte(0);                             // byte mode now
+  unsigned long before = chip->modeWrites;
+  for(int k=0; k<10; k++) sram.WriteByte(k, k);
+  check(chip->modeWrites==before, "no WRMR between byte accesses");
+  sram.ReadByteArray(0, NULL, 0);
+  check(chip->modeWrites==before+1 && chip->mode==Sequential, "one WRMR to go sequential");
+  check(sram.ReadMode()==Sequential, "ReadMode reports the chip's mode");
+  sram.SetSequentialOnly(true);
+  before = chip->modeWrites;
+  sram.WriteByte(5, 1);
+  check(chip->modeWrites==before, "SetSequentialOnly keeps single bytes in sequential mode");
+  sram.SetSequentialOnly(false);
+  check(chip->errors==0, "the chip understood every command");
+}
+
+/************ A bank of two chips: transfers split where they cross to the next chip **********/
+void banks(){
+  static byte b[1000], bb[1000];
+  for(int k=0; k<1000; k++) b[k] = k*13+1;
+  bank.WriteByteArray(SRAMsize-400, b, 1000);
+  check(SRAMemu::Chip(10)->mem[SRAMsize-1]==b[399] && SRAMemu::Chip(9)->mem[0]==b[400], "bank splits at the chip boundary");
+  bank.ReadByteArray(SRAMsize-400, bb, 1000);
+  check(memcmp(b, bb, sizeof(b))==0, "bank read across chips");
+  long v = 0x11223344L;
+  bank.Write(SRAMsize-2, v);                    // straddles the two chips
+  check(bank.Read<long>(SRAMsize-2)==v, "bank value across chips");
+  bank.WriteByte(2*SRAMsize+5, 0x5A);           // past the end wraps to chip 0
+  check(SRAMemu::Chip(10)->mem[5]==0x5A, "bank wraps past the last chip");
+  static Big big, bigBack;
+  fillBig(big, 9);
+  bank.Write(SRAMsize-100, big);                // 100 bytes on chip 0, the rest on chip 1
+  bank.Read(SRAMsize-100, bigBack);
+  check(memcmp(&big, &bigBack, sizeof(Big))==0 && SRAMemu::Chip(9)->mem[0]==big.data[100],
+        "bank struct over 255 bytes across chips");
+}
+
+/************ Fill, Copy and Compare, including overlapping and wrapping blocks **********/
+void bulk(){
+  static byte b[200], expect[300];
+  for(int k=0; k<200; k++) b[k] = k*11+3;
+  sram.Fill(0x8000, 0x77, 300);
+  check(SRAMemu::Chip(10)->mem[0x8000]==0x77 && SRAMemu::Chip(10)->mem[0x8000+299]==0x77 &&
+        SRAMemu::Chip(10)->mem[0x8000+300]!=0x77, "Fill covers exactly big bytes");
+  sram.WriteByteArray(0x9000, b, 200);
+  check(sram.Compare(0x9000, b, 200), "Compare finds the same bytes");
+  b[150]++;
+  check(!sram.Compare(0x9000, b, 200), "Compare finds a difference");
+  b[150]--;
+
+  sram.Copy(0x9000, 0x9000+50, 200);            // destination inside the source: copied from the end
+  memcpy(expect, b, 50);
+  memcpy(expect+50, b, 200);
+  check(sram.Compare(0x9000, expect, 250), "Copy forward over an overlap");
+  sram.WriteByteArray(0x9000, b, 200);
+  sram.Copy(0x9000, 0x9000-50, 200);            // source inside the destination: copied from the start
+  memcpy(expect, b, 200);
+  memcpy(expect+200, b+150, 50);
+  check(sram.Compare(0x9000-50, expect, 250), "Copy backward over an overlap");
+
+  sram.WriteByteArray(SRAMsize-60, b, 200);     // 60 bytes at the end, 140 from 0
+  sram.Copy(SRAMsize-60, 0xA000, 200);          // source wraps
+  check(sram.Compare(0xA000, b, 200), "Copy from a block that wraps at 0x1FFFF");
+  sram.Copy(0xA000, SRAMsize-30, 200);          // destination wraps
+  check(sram.Compare(SRAMsize-30, b, 200) && SRAMemu::Chip(10)->mem[0]==b[30], "Copy to a block that wraps at 0x1FFFF");
+  sram.WriteByteArray(SRAMsize-60, b, 200);
+  sram.Copy(SRAMsize-60, SRAMsize-20, 200);     // overlapping, and wrapping on both sides
+  memcpy(expect, b, 40);
+  memcpy(expect+40, b, 200);
+  check(sram.Compare(SRAMsize-60, expect, 240), "Copy over an overlap that wraps");
+}
+
+/************ Cache: hits stay in RAM, dirty lines reach the chip on eviction or Flush() **********/
+void caches(){
+  SRAMcache<> cache(sram);                      // 4 lines of 32 bytes
+  uint8_t *mem = SRAMemu::Chip(10)->mem;
+  sram.Fill(0xB000, 0, 256);
+  cache.Write(0xB000, 1234);
+  check(sram.ReadInt(0xB000)==0, "cache holds a write back until it has to");
+  check(cache.Read<int>(0xB000)==1234, "cache reads its own write");
+  cache.Flush();
+  check(sram.ReadInt(0xB000)==1234, "Flush writes dirty lines to the chip");
+  cache.ResetCounters();
+  for(int k=0; k<32; k++) cache.Read<byte>(0xB000+k);
+  check(cache.Hits()==32 && cache.Misses()==0, "reads inside a cached line are hits");
+  for(int k=0; k<5; k++) cache.Write<byte>(0xB000+k*32, k+1);   // 5 lines through 4: one goes back
+  check(cache.WriteBacks()>=1 && mem[0xB000]==1, "a dirty line is written back when evicted");
+  cache.Flush();
+  check(mem[0xB000+4*32]==5, "every line reaches the chip after Flush");
+  static byte b[100], bb[100];
+  for(int k=0; k<100; k++) b[k] = k+40;
+  cache.WriteBytes(0xB000+10, b, 100);          // spans 4 lines
+  cache.ReadBytes(0xB000+10, bb, 100);
+  check(memcmp(b, bb, 100)==0, "WriteBytes/ReadBytes across lines");
+  cache.Flush();
+  check(sram.Compare(0xB000+10, b, 100), "bytes across lines reach the chip");
+  static Big big, bigBack;
+  fillBig(big, 4);
+  cache.Write(0xC000, big);
+  cache.Read(0xC000, bigBack);
+  cache.Flush();
+  check(memcmp(&big, &bigBack, sizeof(Big))==0 && sram.Read<Big>(0xC000).last==4, "cache struct over 255 bytes");
+}
+
+/************ Ring: FIFO order, wrap on the chip, and overflow counting **********/
+void rings(){
+  SRAMring<int, 4> ring(sram, 0xD000, 10);      // 2 staging blocks of 4, 10 values on the chip
+  int v = 0, out[10];
+  bool order = true;
+  for(int round=0; round<5; round++){           // 5*6 values through a ring of 10: wraps on the chip
+    for(int k=0; k<6; k++) ring.Push(round*6+k);
+    ring.Flush();
+    for(int k=0; k<6; k++){
+      if(!ring.Pop(v) || v!=round*6+k) order = false;
+    }
+  }
+  check(order && ring.Overflows()==0, "ring keeps FIFO order across the end of its space");
+  check(ring.Available()==0 && !ring.Pop(v), "ring is empty after popping everything");
+
+  for(int k=0; k<8; k++) ring.Push(k);          // both staging blocks full...
+  check(!ring.Push(8) && ring.Overflows()==1, "ring drops a value when both staging blocks are full");
+  ring.Service();
+  for(int k=0; k<4; k++) ring.Push(100+k);
+  ring.Service();                               // 12 values for 10 places: 2 dropped
+  check(ring.Available()==10 && ring.Overflows()==3 && ring.HighWater()==10, "ring drops values when the chip is full");
+  check(ring.Pop(out, 10)==10 && out[0]==0 && out[7]==7 && out[8]==100 && out[9]==101, "ring keeps the oldest values when full");
+  ring.Clear();
+  check(ring.Overflows()==0 && ring.Available()==0, "Clear empties the ring");
+}
+
+/************ Allocators: arena alignment, marks and failure; pool reuse and bounds **********/
+void allocators(){
+  SRAMarena arena(0x10000, 1000);
+  uint32_t a = arena.Alloc(10);
+  uint32_t b = arena.Alloc(10, 32);
+  check(a==0x10000 && b==0x10020 && arena.Padding()==22, "arena aligns allocations");
+  check(arena.Alloc(5, 0)==0x1002A, "arena takes align 0 as 1");
+  uint32_t mark = arena.Mark();
+  arena.Alloc(500);
+  arena.Release(mark);
+  check(arena.Alloc(1)==0x1002F, "Release frees back to a mark");
+  check(arena.Alloc(2000)==SRAMnull && arena.Failures()==1, "arena fails when full");
+  arena.Reset();
+  check(arena.Used()==0 && arena.Free()==1000, "Reset frees everything");
+
+  SRAMpool<> pool(sram, 0x11000, 20, 3);
+  uint32_t p0 = pool.Alloc(), p1 = pool.Alloc(), p2 = pool.Alloc();
+  check(p0==0x11000 && p1==0x11014 && p2==0x11028, "pool hands out blocks in order");
+  check(pool.Alloc()==SRAMnull && pool.Failures()==1, "pool fails when every block is in use");
+  sram.WriteLong(p2, 0x12345678L);              // the free chain must not touch blocks in use
+  check(pool.Free(p1) && pool.Free(p0) && pool.Alloc()==p0 && pool.Alloc()==p1, "pool reuses freed blocks, last freed first");
+  check(sram.ReadLong(p2)==0x12345678L, "pool leaves blocks in use alone");
+  check(!pool.Free(p0+1) && !pool.Free(0x12000), "pool refuses handles that aren't its blocks");
+  SRAMpool<> paged(sram, 0x11101, 20, 4, true);
+  uint32_t q = paged.Alloc();
+  check(paged.BlockSize()==32 && q==0x11120, "page-aligned pool rounds the size and the start");
+}
+
+/************ Array: a[i] through a window, written back in bursts **********/
+void windows(){
+  {
+    SRAMarray<int, 16> a(sram, 0x12000, 100);
+    for(uint32_t k=0; k<100; k++) a[k] = k*k;
+    a.Flush();
+    bool ok = true;
+    for(int k=0; k<100; k++) if(sram.ReadInt(0x12000+k*sizeof(int))!=k*k) ok = false;
+    check(ok, "SRAMarray writes reach the chip");
+    long sum = 0;
+    for(uint32_t k=100; k>0; k--) sum += a[k-1];  // backwards
+    check(sum==328350L, "SRAMarray reads backwards");
+    sum = 0;
+    for(int x : a) sum += x;
+    check(sum==328350L, "SRAMarray iterates");
+    a[5] += 10;
+    check((int)a[5]==35 && (int)a[105]==35, "SRAMarray updates in place and wraps indexes past the end");
+  }                                             // destructor flushes
+  check(sram.ReadInt(0x12000+5*sizeof(int))==35, "SRAMarray flushes when it goes away");
+  SRAMarray<int, 4> none(sram, 0x12000, 0);
+  check(none.Size()==1, "SRAMarray takes size 0 as 1");
+}
+
+/************ CRC-checked blocks: known check values, and damage is noticed **********/
+void checks(){
+  SRAMcheck<> c16(sram);
+  SRAMcheck<uint32_t> c32(sram);
+  c16.WriteArray(0x13000, "123456789", 9);      // standard check values, stored high byte first
+  check(sram.ReadByte(0x13009)==0x29 && sram.ReadByte(0x1300A)==0xB1, "CRC-16/CCITT-FALSE check value");
+  c32.WriteArray(0x13100, "123456789", 9);
+  check(sram.Read<uint32_t>(0x13109)==0xCBF43926UL, "CRC-32 check value");
+  static long l[20], ll[20];
+  for(int k=0; k<20; k++) l[k] = k*1000003L;
+  c16.WriteArray(0x13200, l, 20);
+  check(c16.ReadArray(0x13200, ll, 20) && memcmp(l, ll, sizeof(l))==0, "SRAMcheck reads back a good block");
+  SRAMemu::Chip(10)->mem[0x13200+7] ^= 0x10;    // damage one bit
+  check(!c16.ReadArray(0x13200, ll, 20) && c16.Errors()==1, "SRAMcheck notices a flipped bit");
+  static Big big[2], bigBack[2];
+  fillBig(big[0], 6);
+  fillBig(big[1], 7);
+  c32.WriteArray(0x13400, big, 2);
+  check(c32.ReadArray(0x13400, bigBack, 2) && memcmp(big, bigBack, sizeof(big))==0, "SRAMcheck with elements over 255 bytes");
+}
+
+/************ Packed samples: exact round trip, smaller than raw, random access across blocks **********/
+void packs(){
+  static int16_t s[1000], d[1000];
+  for(int k=0; k<1000; k++) s[k] = 500+(k%37)-(k%11)*2;   // slowly moving, like a sensor
+  SRAMpack<> p(sram, 0x14000, 4000);
+  uint32_t bytes = p.WriteArray(0x14000, s, 1000);
+  check(bytes==SRAMpack<>::Bytes(s, 1000) && bytes<1000*sizeof(int16_t)/2, "SRAMpack packs slow data to under half");
+  check(p.ReadArray(0x14000, d, 1000)==bytes && memcmp(s, d, sizeof(s))==0, "SRAMpack round trip");
+  s[500] = -30000;                              // a jump: wider, but still exact
+  p.WriteArray(0x14000, s, 1000);
+  p.ReadArray(0x14000, d, 1000);
+  check(memcmp(s, d, sizeof(s))==0, "SRAMpack round trip with a jump");
+  for(int k=0; k<10; k++) check(p.Append(s+k*100, 100), "SRAMpack Append");
+  check(p.Samples()==1000 && p.Blocks()==10, "SRAMpack counts blocks and samples");
+  check(p.Read(250, d, 300)==300 && memcmp(s+250, d, 300*sizeof(int16_t))==0, "SRAMpack Read across blocks");
+  check(p.Read(990, d, 50)==10, "SRAMpack Read stops at the last sample");
+  SRAMpack<2> small(sram, 0x15000, 100);
+  check(small.Append(s, 10) && !small.Append(s, 1000), "SRAMpack refuses a block that doesn't fit");
+}
+
+/************ Async: transfers move on Poll(), callbacks run, the queue has a limit **********/
+int callbacks = 0;
+void counted(SRAMhandle){ callbacks++; }
+
+void asyncs(){
+  SRAMasync async(sram);
+  static byte b[300], bb[300];
+  for(int k=0; k<300; k++) b[k] = k*3+1;
+  SRAMhandle w = async.WriteAsync(0x15000, b, 300);
+  SRAMhandle r = async.ReadAsync(0x15000, bb, 300, counted);
+  check(!async.Done(w) && async.Busy(), "async transfers wait for Poll");
+  async.Poll();
+  check(!async.Done(w), "one Poll moves one chunk");
+  async.Wait(r);
+  check(async.Done(w) && !async.Busy() && callbacks==1, "async transfers finish in order and call back");
+  check(memcmp(b, bb, 300)==0, "async read gets what async write sent");
+  for(int k=0; k<AsyncQueueSize; k++) async.ReadAsync(0x15000, bb, 10);
+  check(async.ReadAsync(0x15000, bb, 10)==AsyncNone, "async queue refuses a request when full");
+  while(async.Busy()) async.Poll();
+  check(async.Done(w), "a handle stays done after its slot is reused");
+}
+
+/************ Quad bus: SQI and SDI transfers on the bit-banged pins, then back to SPI **********/
+void quads(){
+  SRAMquad quad(A4, A0, A1, A2, A3);
+  SRAMquad two(A4, A0, A1);                     // SIO2 and SIO3 not wired
+  check(quad.GetWidth()==4 && two.GetWidth()==2, "SRAMquad width follows the wired pins");
+  SRAMemu::Wire(A4, A0, A1, A2, A3);
+  SRAM23LC1024 *chip = SRAMemu::Chip(10);
+  static byte b[100], bb[100];
+  for(int k=0; k<100; k++) b[k] = k*5+2;
+  sram.SetBus(&quad);
+  check(chip->io==EMU_SQI, "SetBus(quad) puts the chip in SQI mode");
+  sram.WriteByteArray(0x16000, b, 100);
+  sram.ReadByteArray(0x16000, bb, 100);
+  check(memcmp(b, bb, 100)==0 && chip->mem[0x16000+99]==b[99], "SQI write and read");
+  sram.WriteInt(0x16100, -777);
+  check(sram.ReadInt(0x16100)==-777, "SQI single values");
+  sram.SetBus(&two);
+  check(chip->io==EMU_SDI, "SetBus(two pins) puts the chip in SDI mode");
+  sram.ReadByteArray(0x16000, bb, 100);
+  check(memcmp(b, bb, 100)==0, "SDI read");
+  sram.SetBus(0);
+  check(chip->io==EMU_SPI && sram.Compare(0x16000, b, 100), "SetBus(0) goes back to SPI");
+  check(chip->errors==0, "the chip understood every quad command");
+}
+
+/************ Batches: joined into few commands, and every value where it belongs **********/
+void batches(){
+  SRAMbatch<> batch(sram);
+  int a = 1111, b = 2222, c = 3333;
+  batch.Write(0x5004, b);                       // out of order: Run() sorts them
+  batch.Write(0x5000, a);
+  batch.Write(0x5000+2*sizeof(int), c);
+  check(batch.Run()==1, "batch joins neighbouring writes into one command");
+  check(sram.ReadInt(0x5000)==a && sram.ReadInt(0x5000+sizeof(int))==b && sram.ReadInt(0x5000+2*sizeof(int))==c,
+        "batch writes land at their addresses");
+  int ra = 0, rc = 0;
+  batch.Read(0x5000, ra);
+  batch.Read(0x5000+2*sizeof(int), rc);         // sizeof(int) bytes apart: within the gap
+  check(batch.Run()==1 && ra==a && rc==c, "batch joins reads across a gap");
+  batch.Read(0x5000, ra);
+  batch.Read(0x6000, rc);
+  check(batch.Run()==2, "batch keeps far reads apart");
+
+  static Big big, back;
+  fillBig(big, 3);
+  int before = 77, after = 88, rb = 0, ra2 = 0;
+  batch.Write(0x7000, before);
+  batch.Write(0x7000+sizeof(int), big);         // 300+ bytes, then the int right after it
+  batch.Write(0x7000+sizeof(int)+sizeof(Big), after);
+  check(batch.Run()==1, "batch joins writes around a struct over 255 bytes");
+  check(sram.ReadInt(0x7000+sizeof(int)+sizeof(Big))==after, "value after a big struct lands at the right address");
+  batch.Read(0x7000, rb);
+  batch.Read(0x7000+sizeof(int), back);
+  batch.Read(0x7000+sizeof(int)+sizeof(Big), ra2);
+  check(batch.Run()==1 && rb==before && ra2==after && memcmp(&big, &back, sizeof(Big))==0,
+        "batch reads a struct over 255 bytes");
+}
+
+void setup(){
+  Serial.begin(9600);
+  SPI.begin();
+  values();
+  arrays();
+  modes();
+  banks();
+  bulk();
+  caches();
+  rings();
+  batches();
+  allocators();
+  windows();
+  checks();
+  packs();
+  asyncs();
+  quads();
+  Serial.print(failures ? "FAILED: " : "passed, failures: ");
+  Serial.println(failures);
+  fflush(stdout);
+  exit(failures ? 1 : 0);
+}
+
+void loop(){
+}